@@ -0,0 +1,562 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        main.cpp                                  //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+//CorePuzzle15
+#include "../include/CorePuzzle15.h"
+
+USING_NS_COREPUZZLE15;
+using namespace std;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Allocation counting                                                        //
+////////////////////////////////////////////////////////////////////////////////
+//Every allocation of the process goes through here, so each
+//benchmark can report how many allocations it does per iteration.
+static std::atomic<uint64_t> g_allocationsCount(0);
+
+void* operator new(size_t size)
+{
+    ++g_allocationsCount;
+    if(auto p = malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Harness                                                                    //
+////////////////////////////////////////////////////////////////////////////////
+//Google-benchmark like state - The benchmark body loops while
+//keepRunning() is true and the harness picks the iterations count.
+class State
+{
+public:
+    explicit State(uint64_t iterations) :
+        m_iterations(iterations),
+        m_remaining (iterations)
+    {
+        //Empty...
+    }
+
+    bool keepRunning()
+    {
+        if(m_remaining == 0)
+            return false;
+
+        --m_remaining;
+        return true;
+    }
+
+    uint64_t getIterations() const { return m_iterations; }
+
+private:
+    uint64_t m_iterations;
+    uint64_t m_remaining;
+};
+
+struct Benchmark
+{
+    string                      name;
+    int                         width;
+    int                         height;
+    function<void (State &)>    body;
+};
+
+struct Report
+{
+    string   name;
+    int      width;
+    int      height;
+    uint64_t iterations;
+    double   nanosecondsPerOp;
+    double   allocationsPerOp;
+};
+
+const double kMinSeconds = 0.2;
+
+Report runBenchmark(const Benchmark &benchmark)
+{
+    //Grow the iterations until it runs for kMinSeconds.
+    uint64_t iterations = 1;
+    while(true)
+    {
+        State state(iterations);
+
+        auto allocations = g_allocationsCount.load();
+        auto start       = chrono::steady_clock::now();
+
+        benchmark.body(state);
+
+        auto seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        allocations  = g_allocationsCount.load() - allocations;
+
+        if(seconds >= kMinSeconds || iterations >= (1ull << 40))
+        {
+            Report report;
+            report.name             = benchmark.name;
+            report.width            = benchmark.width;
+            report.height           = benchmark.height;
+            report.iterations       = iterations;
+            report.nanosecondsPerOp = seconds * 1e9 / iterations;
+            report.allocationsPerOp = static_cast<double>(allocations) / iterations;
+            return report;
+        }
+
+        //Aim a bit past the min time, but don't grow more than 100x.
+        auto factor = (seconds > 0) ? (kMinSeconds * 1.4 / seconds) : 100.0;
+        iterations  = static_cast<uint64_t>(iterations * min(max(factor, 2.0), 100.0));
+    }
+}
+
+//Keeps the compiler from throwing away the results.
+template <typename T>
+void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Benchmarks                                                                 //
+////////////////////////////////////////////////////////////////////////////////
+//Cheap deterministic generator for the moves streams.
+struct XorShift
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint32_t next(uint32_t max)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>(state % max);
+    }
+};
+
+//A random coord in the same row or col of the empty tile.
+CoreCoord::Coord randomMove(GameCore &core, XorShift &rng)
+{
+    auto coord = core.getEmptyValueCoord();
+    if(rng.next(2))
+        coord.x = static_cast<int>(rng.next(core.getWidth ()));
+    else
+        coord.y = static_cast<int>(rng.next(core.getHeight()));
+
+    return coord;
+}
+
+//Keeps the game going - A small board may be solved by chance.
+void keepPlaying(GameCore &core, int width, int height, int &seed)
+{
+    if(core.getStatus() != CoreGame::Status::Continue)
+        core = GameCore(width, height, GameCore::kUnlimitedMoves, ++seed);
+}
+
+//Same as the GameCore ones above, with the size fixed at compile time.
+template <int W, int H>
+void addFixedBenchmarks(vector<Benchmark> &benchmarks)
+{
+    typedef FixedGameCore<W, H> Core;
+
+    benchmarks.push_back({ "MoveFast/Fixed", W, H, [](State &state) {
+        int      seed = 1;
+        XorShift rng;
+        Core     core(GameCore::kUnlimitedMoves, seed);
+        while(state.keepRunning())
+        {
+            auto coord = core.getEmptyValueCoord();
+            if(rng.next(2))
+                coord.x = static_cast<int>(rng.next(W));
+            else
+                coord.y = static_cast<int>(rng.next(H));
+
+            auto summary = core.moveFast(coord);
+            doNotOptimize(summary);
+
+            if(core.getStatus() != CoreGame::Status::Continue)
+                core = Core(GameCore::kUnlimitedMoves, ++seed);
+        }
+    }});
+
+    benchmarks.push_back({ "TryMove/Fixed", W, H, [](State &state) {
+        int      seed = 1;
+        XorShift rng;
+        Core     core(GameCore::kUnlimitedMoves, seed);
+        while(state.keepRunning())
+        {
+            auto mask      = core.getLegalMoves();
+            auto direction = GameCore::MoveResult::Direction(rng.next(4));
+            if(!(mask & GameCore::getDirectionBit(direction)))
+                continue;
+
+            auto summary = core.tryMove(direction);
+            doNotOptimize(summary);
+
+            if(core.getStatus() != CoreGame::Status::Continue)
+                core = Core(GameCore::kUnlimitedMoves, ++seed);
+        }
+    }});
+}
+
+vector<Benchmark> makeBenchmarks()
+{
+    vector<Benchmark> benchmarks;
+    const int sizes[] = { 3, 4, 5, 8, 16, 32, 64, 100, 128, 256 };
+
+    for(auto size : sizes)
+    {
+        auto w = size;
+        auto h = size;
+
+        //Shared by the benchmarks that don't move, so
+        //making the Board isn't part of their time.
+        auto board = make_shared<GameCore>(w, h, GameCore::kUnlimitedMoves, 1);
+
+        benchmarks.push_back({ "Construct", w, h, [w, h](State &state) {
+            int seed = 0;
+            while(state.keepRunning())
+            {
+                GameCore core(w, h, GameCore::kUnlimitedMoves, ++seed);
+                doNotOptimize(core);
+            }
+        }});
+
+        benchmarks.push_back({ "Construct/Pooled", w, h, [w, h](State &state) {
+            int seed = 0;
+            while(state.keepRunning())
+            {
+                auto core = GameCorePool::acquire(w, h, GameCore::kUnlimitedMoves, ++seed);
+                doNotOptimize(core);
+            }
+        }});
+
+        //Only the Board - Seeded engine against a counter based stream.
+        benchmarks.push_back({ "MakeBoard/Seed", w, h, [w, h](State &state) {
+            int       seed = 0;
+            FlatBoard board(w, h);
+            while(state.keepRunning())
+            {
+                PuzzleGenerator::makeBoard(++seed, board);
+                doNotOptimize(board);
+            }
+        }});
+
+        benchmarks.push_back({ "MakeBoard/Series", w, h, [w, h](State &state) {
+            uint64_t  index = 0;
+            FlatBoard board(w, h);
+            while(state.keepRunning())
+            {
+                PuzzleGenerator::makeSeriesBoard(1, ++index, board);
+                doNotOptimize(board);
+            }
+        }});
+
+        benchmarks.push_back({ "Move/Random", w, h, [w, h](State &state) {
+            int      seed = 1;
+            XorShift rng;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            while(state.keepRunning())
+            {
+                auto result = core.move(randomMove(core, rng));
+                doNotOptimize(result);
+                keepPlaying(core, w, h, seed);
+            }
+        }});
+
+        benchmarks.push_back({ "MoveFast/Random", w, h, [w, h](State &state) {
+            int      seed = 1;
+            XorShift rng;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            while(state.keepRunning())
+            {
+                auto summary = core.moveFast(randomMove(core, rng));
+                doNotOptimize(summary);
+                keepPlaying(core, w, h, seed);
+            }
+        }});
+
+        //A random walk of single tiles, as the search bots do.
+        benchmarks.push_back({ "TryMove/Legal", w, h, [w, h](State &state) {
+            int      seed = 1;
+            XorShift rng;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            while(state.keepRunning())
+            {
+                auto mask      = core.getLegalMoves();
+                auto direction = GameCore::MoveResult::Direction(rng.next(4));
+                if(!(mask & GameCore::getDirectionBit(direction)))
+                    continue;
+
+                auto summary = core.tryMove(direction);
+                doNotOptimize(summary);
+                keepPlaying(core, w, h, seed);
+            }
+        }});
+
+        //Same as above reading a heuristic after each move - The
+        //cost of keeping them against computing one from scratch.
+        benchmarks.push_back({ "MoveFast/Tracked", w, h, [w, h](State &state) {
+            int      seed = 1;
+            XorShift rng;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            core.setHeuristicsTracking(true);
+            while(state.keepRunning())
+            {
+                core.moveFast(randomMove(core, rng));
+                doNotOptimize(core.getHeuristic(Heuristics::Kind::LinearConflict));
+
+                if(core.getStatus() != CoreGame::Status::Continue)
+                {
+                    core.reset(w, h, GameCore::kUnlimitedMoves, ++seed);
+                    core.setHeuristicsTracking(true);
+                }
+            }
+        }});
+
+        benchmarks.push_back({ "Heuristic/Evaluate", w, h, [board](State &state) {
+            while(state.keepRunning())
+            {
+                doNotOptimize(board->getHeuristic(Heuristics::Kind::LinearConflict));
+            }
+        }});
+
+        //64 moves per iteration - Back and forth
+        //in the row of the empty tile.
+        benchmarks.push_back({ "ApplyMoves/64", w, h, [w, h](State &state) {
+            typedef GameCore::MoveResult::Direction Direction;
+
+            vector<Direction> toLeft, toRight;
+            for(int i = 0; i < 32; ++i)
+            {
+                toLeft .insert(toLeft .end(), { Direction::Left,  Direction::Right });
+                toRight.insert(toRight.end(), { Direction::Right, Direction::Left  });
+            }
+
+            int      seed = 1;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            while(state.keepRunning())
+            {
+                auto &moves = (core.getEmptyValueCoord().x > 0) ? toLeft : toRight;
+                auto  batch = core.applyMoves(moves);
+                doNotOptimize(batch);
+
+                core.clearHistory();
+                keepPlaying(core, w, h, seed);
+            }
+        }});
+
+        //Worst case - Each move shifts (width - 1) tiles.
+        benchmarks.push_back({ "Move/LongRow", w, h, [w, h](State &state) {
+            int      seed = 1;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            GameCore::MoveResult result;
+            while(state.keepRunning())
+            {
+                auto coord = core.getEmptyValueCoord();
+                coord.x    = (coord.x == 0) ? w -1 : 0;
+
+                core.move(coord, result);
+                doNotOptimize(result);
+                keepPlaying(core, w, h, seed);
+            }
+        }});
+
+        benchmarks.push_back({ "GetBoard", w, h, [w, h](State &state) {
+            int      seed = 1;
+            XorShift rng;
+            GameCore core(w, h, GameCore::kUnlimitedMoves, seed);
+            while(state.keepRunning())
+            {
+                core.moveFast(randomMove(core, rng));
+                doNotOptimize(core.getBoard());
+                keepPlaying(core, w, h, seed);
+            }
+        }});
+
+        //Board kernels - The scalar code and the best the CPU has.
+        typedef BoardKernels::InstructionSet InstructionSet;
+        const InstructionSet instructionSets[] = {
+            InstructionSet::Scalar,
+            BoardKernels::getBestInstructionSet()
+        };
+        const char *instructionSetNames[] = { "Scalar", "SSE2", "AVX2" };
+
+        for(auto instructionSet : instructionSets)
+        {
+            auto suffix = string("/") + instructionSetNames[static_cast<int>(instructionSet)];
+
+            benchmarks.push_back({ "Manhattan" + suffix, w, h, [board, instructionSet](State &state) {
+                BoardKernels::setInstructionSet(instructionSet);
+                while(state.keepRunning())
+                    doNotOptimize(BoardKernels::manhattanDistance(board->getFlatBoard()));
+            }});
+
+            benchmarks.push_back({ "CorrectTiles" + suffix, w, h, [board, instructionSet](State &state) {
+                BoardKernels::setInstructionSet(instructionSet);
+                while(state.keepRunning())
+                    doNotOptimize(BoardKernels::countCorrectTiles(board->getFlatBoard()));
+            }});
+
+            //Pairwise up to 64x64 - The bigger ones are O(n log n).
+            benchmarks.push_back({ "Inversions" + suffix, w, h, [board, instructionSet](State &state) {
+                BoardKernels::setInstructionSet(instructionSet);
+                while(state.keepRunning())
+                    doNotOptimize(BoardKernels::countInversions(board->getFlatBoard()));
+            }});
+        }
+        BoardKernels::setInstructionSet(BoardKernels::getBestInstructionSet());
+
+        benchmarks.push_back({ "Ascii", w, h, [board](State &state) {
+            while(state.keepRunning())
+            {
+                auto str = board->ascii();
+                doNotOptimize(str);
+            }
+        }});
+
+        benchmarks.push_back({ "Ascii/Reuse", w, h, [board](State &state) {
+            string str;
+            while(state.keepRunning())
+            {
+                board->ascii(str);
+                doNotOptimize(str);
+            }
+        }});
+    }
+
+    addFixedBenchmarks<3, 3>(benchmarks);
+    addFixedBenchmarks<4, 4>(benchmarks);
+    addFixedBenchmarks<5, 5>(benchmarks);
+
+    return benchmarks;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Main                                                                       //
+////////////////////////////////////////////////////////////////////////////////
+void usage()
+{
+    cout << "Amazing Cow - CorePuzzle15 Benchmarks" << endl;
+    cout << "Usage: " << endl;
+    cout << "   bench <output json> [name filter]" << endl;
+    cout << "Example: " << endl;
+    cout << "   bench results.json" << endl;
+    cout << "   bench results.json MoveFast" << endl;
+
+    exit(1);
+}
+
+int main(int argc, const char *argv[])
+{
+    if(argc < 2 || argc > 3)
+        usage();
+
+    string filter = (argc == 3) ? argv[2] : "";
+
+    vector<Report> reports;
+    for(const auto &benchmark : makeBenchmarks())
+    {
+        if(benchmark.name.find(filter) == string::npos)
+            continue;
+
+        auto report = runBenchmark(benchmark);
+        reports.push_back(report);
+
+        fprintf(stderr, "%-20s %4dx%-4d %14.1f ns/op %10.2f allocs/op\n",
+                report.name.c_str(), report.width, report.height,
+                report.nanosecondsPerOp, report.allocationsPerOp);
+    }
+
+    //Same layout of google-benchmark JSON output, so
+    //the same tools can be used to compare the runs.
+    auto file = fopen(argv[1], "w");
+    if(!file)
+    {
+        cerr << "Failed to open: " << argv[1] << endl;
+        return 1;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"context\": {\n");
+    fprintf(file, "    \"library\": \"CorePuzzle15\",\n");
+    fprintf(file, "    \"version\": \"%s\"\n", COW_COREPUZZLE15_VERSION);
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"benchmarks\": [\n");
+    for(size_t i = 0; i < reports.size(); ++i)
+    {
+        const auto &report = reports[i];
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"name\": \"%s/%dx%d\",\n", report.name.c_str(), report.width, report.height);
+        fprintf(file, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(report.iterations));
+        fprintf(file, "      \"real_time\": %.3f,\n", report.nanosecondsPerOp);
+        fprintf(file, "      \"time_unit\": \"ns\",\n");
+        fprintf(file, "      \"allocations_per_iteration\": %.3f\n", report.allocationsPerOp);
+        fprintf(file, "    }%s\n", (i + 1 < reports.size()) ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+    fclose(file);
+
+    return 0;
+}
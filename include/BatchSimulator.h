@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BatchSimulator.h                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_BatchSimulator_h__
+#define __CorePuzzle15_include_BatchSimulator_h__
+
+//std
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "CacheLineArray.h"
+#include "GameCore.h"
+//CoreCoord
+#include "CoreCoord.h"
+//CoreGame
+#include "CoreGame.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Replays many recorded games at once on a pool of threads.
+///     Each job is a (width, height, maxMoves, seed, moves) game,
+///     the moves are applied in order with GameCore::applyMoves()
+///     until the list ends, the game is over or a move can't be
+///     done - So a corrupt move list stops the job, it never
+///     touches cells out of the Board.
+///@note
+///     The jobs are split in one contiguous range per thread. When a
+///     thread runs out of it's own range it steals chunks from the
+///     ranges of the others - Taking a chunk is a single atomic
+///     add, so there are no locks while the jobs run.
+///@note
+///     The threads are started once by the CTOR and sleep between
+///     run() calls. run() is not reentrant - Use one BatchSimulator
+///     per caller thread.
+class BatchSimulator
+{
+    // Inner Types //
+public:
+    struct Job
+    {
+        //CTOR
+        Job() :
+            width   (0),
+            height  (0),
+            maxMoves(GameCore::kUnlimitedMoves),
+            seed    (0)
+        {
+            //Empty...
+        }
+
+        Job(int width, int height, int maxMoves, int seed,
+            const CoreCoord::Coord::Vec &moves) :
+            width   (width),
+            height  (height),
+            maxMoves(maxMoves),
+            seed    (seed),
+            moves   (moves)
+        {
+            //Empty...
+        }
+
+        //Vars
+        int                   width;
+        int                   height;
+        int                   maxMoves;
+        int                   seed;
+        CoreCoord::Coord::Vec moves;
+    };
+
+    struct JobResult
+    {
+        //CTOR
+        JobResult() :
+            status            (CoreGame::Status::Continue),
+            movesCount        (0),
+            stopReason        (GameCore::BatchResult::StopReason::Completed),
+            stopIndex         (0),
+            elapsedNanoseconds(0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        CoreGame::Status                  status;
+        int                               movesCount;         ///< GameCore::getMovesCount().
+        GameCore::BatchResult::StopReason stopReason;         ///< Why the replay stopped.
+        size_t                            stopIndex;          ///< First move of the list not applied.
+        uint64_t                          elapsedNanoseconds; ///< Time to build and replay.
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs the simulator and starts it's threads.
+    ///@param threadsCount
+    ///     How many threads will run the jobs.
+    ///     0 (default) uses one per hardware thread.
+    explicit BatchSimulator(int threadsCount = 0);
+    ~BatchSimulator();
+
+    BatchSimulator(const BatchSimulator &) = delete;
+    BatchSimulator& operator =(const BatchSimulator &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief Runs all jobs and waits for them.
+    ///@returns The results in the same order of jobs.
+    std::vector<JobResult> run(const std::vector<Job> &jobs);
+
+    ///@brief
+    ///     Runs jobsCount jobs and waits for them.
+    ///     results[i] is filled with the result of jobs[i].
+    void run(const Job *jobs, size_t jobsCount, JobResult *results);
+
+    ///@brief Gets how many threads run the jobs.
+    int getThreadsCount() const;
+
+
+    // Private Types //
+private:
+    //A cache line each, so the threads don't fight for them.
+    struct alignas(COREPUZZLE15_CACHE_LINE_SIZE) Range
+    {
+        std::atomic<size_t> next;
+        size_t              end;
+    };
+
+
+    // Private Methods //
+private:
+    void workerLoop(int workerIndex);
+    void runRange  (Range &range);
+    void runJob    (const Job &job, JobResult &result);
+
+
+    // iVars //
+private:
+    int                      m_threadsCount;
+    std::vector<std::thread> m_threads;
+    CacheLineArray<Range>    m_ranges;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    uint64_t                m_generation;
+    int                     m_pendingWorkers;
+    bool                    m_quit;
+
+    const Job *m_jobs;
+    JobResult *m_results;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_BatchSimulator_h__) //
@@ -0,0 +1,318 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BoardGenerator.h                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_BoardGenerator_h__
+#define __CorePuzzle15_include_BoardGenerator_h__
+
+//std
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "CounterRandom.h"
+#include "FlatBoard.h"
+#include "Heuristics.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Fills FlatBoards with shuffled values that are
+///     always solvable - No board is ever generated and
+///     then thrown away.
+///@note
+///     All the randomness comes from the URNG passed by the
+///     caller, so the same generator state always produces
+///     the same Board. The std distributions that turn it into
+///     ranges differ between standard libraries, except with a
+///     CounterRandom, which is mapped by CounterRandom::getBounded().
+class BoardGenerator
+{
+    // Inner Types //
+public:
+    ///@brief
+    ///     Band of Manhattan distances (inclusive) that
+    ///     a generated Board must be from the solved Board.
+    ///@see Heuristics::manhattanDistance().
+    struct Difficulty
+    {
+        //CTOR
+        Difficulty(int minDistance, int maxDistance) :
+            minDistance(minDistance),
+            maxDistance(maxDistance)
+        {
+            //Empty...
+        }
+
+        //Vars
+        int minDistance;
+        int maxDistance;
+    };
+
+    ///@brief
+    ///     The Board at index of the series of seed - Shuffled by
+    ///     the CounterRandom stream (seed, index), so it's the same
+    ///     on any machine and made alone in O(width * height).
+    ///@see generateSeries(), PuzzleGenerator::makeSeriesBoard().
+    struct Series
+    {
+        //CTOR
+        Series(uint64_t seed, uint64_t index) :
+            seed (seed),
+            index(index)
+        {
+            //Empty...
+        }
+
+        //Vars
+        uint64_t seed;
+        uint64_t index;
+    };
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Fills board with an uniformly random solvable arrangement.
+    ///     The parity is fixed in O(width * height) with no retries.
+    ///@param board The board to fill - It's dimensions are kept.
+    ///@param rng   The random number generator.
+    template <typename URNG>
+    static void generate(FlatBoard &board, URNG &rng);
+
+    ///@brief
+    ///     Fills board with a solvable arrangement whose Manhattan
+    ///     distance is inside the difficulty band. The board is
+    ///     made by a random walk of the empty tile from the solved
+    ///     Board, so it's always solvable.
+    ///@param board      The board to fill - It's dimensions are kept.
+    ///@param difficulty
+    ///     The distance band - A negative minDistance is taken as 0
+    ///     and a maxDistance below minDistance as minDistance.
+    ///@param rng        The random number generator.
+    ///@warning
+    ///     If the band is beyond the reach of board the walk gives
+    ///     up after a bounded number of steps, keeping the Board
+    ///     where it stopped - It's never farther than maxDistance,
+    ///     but it may be closer than minDistance.
+    template <typename URNG>
+    static void generate(FlatBoard &board,
+                         const Difficulty &difficulty,
+                         URNG &rng);
+
+    ///@brief
+    ///     Fills board with the Board of series - The same cells
+    ///     with any compiler and standard library.
+    ///@param board  The board to fill - It's dimensions are kept.
+    ///@param series The seed and index of the Board in the series.
+    static void generateSeries(FlatBoard &board, const Series &series);
+
+    ///@brief
+    ///     Checks if board can be solved, i.e. if the solved
+    ///     Board can be reached by sliding the tiles.
+    static bool isSolvable(const FlatBoard &board);
+
+    ///@brief Sets board to the solved arrangement.
+    static void setSolved(FlatBoard &board);
+
+
+    // Private Methods //
+private:
+    //A number in [min, max] - The std distribution for any URNG,
+    //the fully specified mapping for a CounterRandom.
+    template <typename URNG>
+    static int getRandomInt(URNG &rng, int min, int max);
+    static int getRandomInt(CounterRandom &rng, int min, int max);
+
+    template <typename T, typename URNG>
+    static bool shuffleCells(T *cells, int count, URNG &rng);
+
+    static void fixParity(FlatBoard &board, bool permutationIsOdd);
+    static void generateLine(FlatBoard &board, int emptyIndex);
+
+    static int getNeighbors(const FlatBoard &board, int index,
+                            int neighbors[4]);
+};
+
+
+// Public Methods //
+template <typename URNG>
+void BoardGenerator::generate(FlatBoard &board, URNG &rng)
+{
+    auto count = board.getCellsCount();
+
+    //Boards with a single row or column can't reorder the tiles,
+    //only the place of the empty one is random.
+    if(board.getWidth() == 1 || board.getHeight() == 1)
+    {
+        generateLine(board, getRandomInt(rng, 0, count -1));
+        return;
+    }
+
+    bool odd;
+    switch(board.getCellSize())
+    {
+        case 1 : odd = shuffleCells(board.getCells<uint8_t >(), count, rng); break;
+        case 2 : odd = shuffleCells(board.getCells<uint16_t>(), count, rng); break;
+        default: odd = shuffleCells(board.getCells<uint32_t>(), count, rng); break;
+    }
+
+    fixParity(board, odd);
+}
+
+template <typename URNG>
+void BoardGenerator::generate(FlatBoard &board,
+                              const Difficulty &difficulty,
+                              URNG &rng)
+{
+    auto width    = board.getWidth();
+    auto count    = board.getCellsCount();
+    auto maxSteps = 64 * count + 1024;
+
+    setSolved(board);
+    if(count < 2)
+        return;
+
+    //A band that starts below the solved Board or ends
+    //before it starts is clamped to a valid one.
+    auto minDistance = std::max(0,           difficulty.minDistance);
+    auto maxDistance = std::max(minDistance, difficulty.maxDistance);
+
+    //Pick the exact distance to walk to, so the
+    //boards are spread over the whole band.
+    auto target = getRandomInt(rng, minDistance, maxDistance);
+
+    int emptyIndex = count -1;
+    int prevIndex  = -1;
+    int distance   = 0;
+    int neighbors[4];
+
+    for(int step = 0; step < maxSteps && distance != target; ++step)
+    {
+        auto neighborsCount = getNeighbors(board, emptyIndex, neighbors);
+        auto first          = getRandomInt(rng, 0, neighborsCount -1);
+
+        //Most of the times take a move that goes toward the target,
+        //the others take any move so the walk doesn't get stuck.
+        auto goToTarget = getRandomInt(rng, 0, 3) != 0;
+
+        int chosenIndex = -1;
+        int chosenDelta =  0;
+
+        for(int i = 0; i < neighborsCount; ++i)
+        {
+            auto index = neighbors[(first + i) % neighborsCount];
+            if(index == prevIndex)
+                continue;
+
+            auto value = board.getValueAt(index);
+            auto delta = Heuristics::getTileDistance(value, emptyIndex, width, count)
+                       - Heuristics::getTileDistance(value, index,      width, count);
+
+            if(distance + delta > maxDistance)
+                continue;
+
+            if(chosenIndex == -1 || ((delta > 0) == (distance < target)))
+            {
+                chosenIndex = index;
+                chosenDelta = delta;
+
+                if(!goToTarget || (delta > 0) == (distance < target))
+                    break;
+            }
+        }
+
+        //Dead end - Going back always decreases the distance.
+        if(chosenIndex == -1)
+        {
+            auto value  = board.getValueAt(prevIndex);
+            chosenIndex = prevIndex;
+            chosenDelta = Heuristics::getTileDistance(value, emptyIndex, width, count)
+                        - Heuristics::getTileDistance(value, prevIndex,  width, count);
+        }
+
+        board.swapValuesAt(emptyIndex, chosenIndex);
+
+        distance  += chosenDelta;
+        prevIndex  = emptyIndex;
+        emptyIndex = chosenIndex;
+    }
+}
+
+
+// Private Methods //
+template <typename URNG>
+int BoardGenerator::getRandomInt(URNG &rng, int min, int max)
+{
+    return std::uniform_int_distribution<int>(min, max)(rng);
+}
+
+inline int BoardGenerator::getRandomInt(CounterRandom &rng, int min, int max)
+{
+    return min + static_cast<int>(rng.getBounded(static_cast<uint32_t>(max - min) + 1));
+}
+
+template <typename T, typename URNG>
+bool BoardGenerator::shuffleCells(T *cells, int count, URNG &rng)
+{
+    std::iota(cells, cells + count, 0);
+
+    //In the iota order each value is one index after it's goal,
+    //so it's a single cycle of length count away from the solved Board.
+    bool odd = ((count -1) % 2) != 0;
+
+    //Fisher-Yates - Each swap of two different cells flips the parity.
+    for(int i = count -1; i > 0; --i)
+    {
+        auto j = getRandomInt(rng, 0, i);
+        if(i != j)
+        {
+            std::swap(cells[i], cells[j]);
+            odd = !odd;
+        }
+    }
+
+    return odd;
+}
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_BoardGenerator_h__) //
@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BoardKernels.h                            //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_BoardKernels_h__
+#define __CorePuzzle15_include_BoardKernels_h__
+
+//std
+#include <cstdint>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Whole Board computations - Tiles in place, Manhattan distance
+///     and inversions - with SSE2 and AVX2 versions. The best one
+///     that the CPU supports is picked at runtime, the others (and
+///     non x86 builds) use the scalar one. All give the same results.
+///@note
+///     The cells are widened to 32 bits lanes, 4 (SSE2) or 8 (AVX2)
+///     at once, for all the FlatBoard cell sizes. The goal row and
+///     col of the values are found with float divisions, which are
+///     exact for Boards below kMaxVectorCellsCount.
+class BoardKernels
+{
+    // Constants / Enums / Typedefs //
+public:
+    enum class InstructionSet {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    ///@brief Bigger Boards always use the scalar code.
+    static const int kMaxVectorCellsCount = 1 << 22;
+
+    ///@brief Bigger Boards count the inversions with a Fenwick tree.
+    static const int kMaxPairwiseCellsCount = 4096;
+
+
+    // Public Methods //
+public:
+    ///@brief Gets the best instruction set that the CPU supports.
+    static InstructionSet getBestInstructionSet();
+
+    ///@brief Gets the instruction set that the kernels are using.
+    static InstructionSet getInstructionSet();
+
+    ///@brief
+    ///     Makes the kernels use instructionSet - Meant for tests
+    ///     and benchmarks. Sets not supported by the CPU are
+    ///     replaced by the best one that is.
+    static void setInstructionSet(InstructionSet instructionSet);
+
+
+    ///@brief
+    ///     Gets how many tiles are at their goal index,
+    ///     i.e. value == index + 1 - The empty tile never counts.
+    ///@see GameCore::getCorrectTileCount().
+    static int countCorrectTiles(const FlatBoard &board);
+
+    ///@brief Gets if all tiles are at their goal index.
+    static bool isSolved(const FlatBoard &board);
+
+    ///@brief
+    ///     Gets the sum of the Manhattan distances of
+    ///     all tiles (but the empty one) to their goal.
+    ///@see Heuristics::manhattanDistance().
+    static int manhattanDistance(const FlatBoard &board);
+
+    ///@brief
+    ///     Gets the number of pairs of tiles (the empty one left
+    ///     out) that are in the reverse order of their values.
+    ///@note
+    ///     The vector versions compare all pairs, so Boards with
+    ///     more than kMaxPairwiseCellsCount cells are counted in
+    ///     O(n log n) with a Fenwick tree instead.
+    static uint64_t countInversions(const FlatBoard &board);
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_BoardKernels_h__) //
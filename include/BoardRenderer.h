@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BoardRenderer.h                           //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_BoardRenderer_h__
+#define __CorePuzzle15_include_BoardRenderer_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Writes Boards as text in a single pass into caller memory -
+///     No streams and, once the string has the capacity, no
+///     allocations.
+///@note
+///     Ascii format (the one of GameCore::ascii()): each value
+///     zero padded to the digits of (width * height), followed by a
+///     space, and a '\n' after each row, e.g. for a 3x3 Board:
+///       "1 2 3 \n4 5 6 \n7 8 0 \n"
+///@note
+///     Delta format: only the cells that a move changed, as
+///     "index:value" pairs (flat index, no padding) separated by
+///     spaces and ended by a '\n', e.g. "5:6 4:0\n". Applying the
+///     pairs to the last Board gives the current one.
+class BoardRenderer
+{
+    // Public Methods //
+public:
+    BoardRenderer() = delete;
+
+    ///@brief Gets the padded digits of each value of the Board.
+    static int getDigitsCount(int width, int height);
+
+    ///@brief Gets the exact size of the ascii of a width x height Board.
+    static size_t getAsciiSize(int width, int height);
+
+
+    ///@brief
+    ///     Writes the ascii of board into buffer (not null terminated).
+    ///@returns
+    ///     The bytes written, or 0 if size is less than getAsciiSize().
+    static size_t ascii(const FlatBoard &board, char *buffer, size_t size);
+
+    ///@brief Sets str to the ascii of board, reusing it's memory.
+    static void ascii(const FlatBoard &board, std::string &str);
+
+    ///@brief
+    ///     Same as ascii(board, buffer, size) for the raw cells of
+    ///     a width x height Board.
+    static size_t ascii(const uint8_t *cells, int width, int height,
+                        char *buffer, size_t size);
+    static size_t ascii(const uint16_t *cells, int width, int height,
+                        char *buffer, size_t size);
+
+
+    ///@brief
+    ///     Gets the max size of the delta of result - The bytes
+    ///     actually written can be less.
+    static size_t getMaxDeltaSize(const FlatBoard &board,
+                                  const GameCore::MoveResult &result);
+
+    ///@brief
+    ///     Writes the cells that result changed, with their values
+    ///     in board (the Board after the move), into buffer.
+    ///@returns
+    ///     The bytes written, or 0 if result has no move or size
+    ///     is less than getMaxDeltaSize().
+    static size_t delta(const FlatBoard &board,
+                        const GameCore::MoveResult &result,
+                        char *buffer, size_t size);
+
+    ///@brief Sets str to the delta of result, reusing it's memory.
+    static void delta(const FlatBoard &board,
+                      const GameCore::MoveResult &result,
+                      std::string &str);
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_BoardRenderer_h__) //
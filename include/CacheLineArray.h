@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        CacheLineArray.h                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_CacheLineArray_h__
+#define __CorePuzzle15_include_CacheLineArray_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+
+
+//Bytes of a cache line on the targets (x86-64 and ARM64) - A macro,
+//so it can be given to alignas() in any header.
+#define COREPUZZLE15_CACHE_LINE_SIZE 64
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Fixed size array whose first item starts at a cache line.
+///     Meant for items that are alignas(COREPUZZLE15_CACHE_LINE_SIZE),
+///     so each one has it's own lines and the threads that write
+///     them don't fight for the lines of the others.
+///@note
+///     new[] and std::vector only give alignof(std::max_align_t)
+///     before C++17 - A bigger alignas() of the item type would be
+///     ignored by them, so the storage is aligned here by hand.
+///@note
+///     The items are value-initialized, in order, by the CTOR (or
+///     reset()) and destroyed in reverse order.
+template <typename T>
+class CacheLineArray
+{
+    static_assert(alignof(T) <= COREPUZZLE15_CACHE_LINE_SIZE,
+                  "Item is aligned beyond a cache line.");
+
+    // CTOR/DTOR //
+public:
+    CacheLineArray();
+    explicit CacheLineArray(size_t count);
+    ~CacheLineArray();
+
+    CacheLineArray(const CacheLineArray &) = delete;
+    CacheLineArray& operator =(const CacheLineArray &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief Destroys the items and makes count new ones.
+    void reset(size_t count);
+
+    inline T& operator [](size_t index)
+    {
+        return m_items[index];
+    }
+
+    inline const T& operator [](size_t index) const
+    {
+        return m_items[index];
+    }
+
+    inline T* get()
+    {
+        return m_items;
+    }
+
+    inline const T* get() const
+    {
+        return m_items;
+    }
+
+    inline size_t size() const
+    {
+        return m_count;
+    }
+
+
+    // Private Methods //
+private:
+    void clear();
+
+
+    // iVars //
+private:
+    std::unique_ptr<char[]> m_buffer;
+    T                      *m_items;
+    size_t                  m_count;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Implementation                                                             //
+////////////////////////////////////////////////////////////////////////////////
+// CTOR/DTOR //
+template <typename T>
+CacheLineArray<T>::CacheLineArray() :
+    m_items(nullptr),
+    m_count(0)
+{
+    //Empty...
+}
+
+template <typename T>
+CacheLineArray<T>::CacheLineArray(size_t count) :
+    m_items(nullptr),
+    m_count(0)
+{
+    reset(count);
+}
+
+template <typename T>
+CacheLineArray<T>::~CacheLineArray()
+{
+    clear();
+}
+
+
+// Public Methods //
+template <typename T>
+void CacheLineArray<T>::reset(size_t count)
+{
+    clear();
+    if(count == 0)
+        return;
+
+    //Room for the items plus the bytes skipped to reach a line.
+    const size_t kLine = COREPUZZLE15_CACHE_LINE_SIZE;
+    m_buffer.reset(new char[count * sizeof(T) + kLine - 1]);
+
+    auto address = reinterpret_cast<uintptr_t>(m_buffer.get());
+    auto aligned = (address + kLine - 1) & ~static_cast<uintptr_t>(kLine - 1);
+    m_items      = reinterpret_cast<T *>(aligned);
+
+    for(; m_count < count; ++m_count)
+        new (m_items + m_count) T();
+}
+
+
+// Private Methods //
+template <typename T>
+void CacheLineArray<T>::clear()
+{
+    while(m_count > 0)
+        m_items[--m_count].~T();
+
+    m_items = nullptr;
+    m_buffer.reset();
+}
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_CacheLineArray_h__) //
@@ -47,6 +47,33 @@
 //this file alone and let it makes all the job. :)
 
 #include "CorePuzzle15_Utils.h"
+#include "BatchSimulator.h"
+#include "BoardGenerator.h"
+#include "BoardKernels.h"
+#include "BoardRenderer.h"
+#include "CacheLineArray.h"
+#include "CounterRandom.h"
+#include "FixedGameCore.h"
+#include "FlatBoard.h"
+#include "GameCorePool.h"
+#include "Heuristics.h"
+#include "HeuristicsTracker.h"
+#include "Metrics.h"
+#include "MoveLog.h"
+#include "MoveLogReader.h"
+#include "MovePipeline.h"
+#include "MoveTable.h"
+#include "ParallelSolver.h"
+#include "PatternDatabase.h"
+#include "PuzzleBank.h"
+#include "PuzzleBankReader.h"
+#include "PuzzleGenerator.h"
+#include "ReductionSolver.h"
+#include "SessionManager.h"
+#include "Solver.h"
+#include "Trace.h"
+#include "WalkingDistance.h"
+#include "Zobrist.h"
 #include "GameCore.h"
 
 #endif // defined(__CorePuzzle15_include_CorePuzzle15_h__) //
@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        CounterRandom.h                           //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_CounterRandom_h__
+#define __CorePuzzle15_include_CounterRandom_h__
+
+//std
+#include <cstdint>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Counter based random number generator - The n-th number of a
+///     stream is SplitMix64 of (key + n * gamma), where the key comes
+///     from the (seed, stream) pair. There's no state besides the
+///     counter, so any number of any stream is made in O(1), with no
+///     seeding cost and the same bits in all threads and processes.
+///@note
+///     Meant to give each Board of a series it's own stream - The
+///     Board at index of a seeded series is made alone, on any core,
+///     without making the ones before it.
+///@note
+///     It's a UniformRandomBitGenerator, so it can be given to the
+///     std distributions - But how they map the bits is up to each
+///     standard library, so only getBounded() gives the same numbers
+///     everywhere. BoardGenerator uses it for CounterRandom.
+///@see PuzzleGenerator::makeSeriesBoard().
+class CounterRandom
+{
+    // Constants / Enums / Typedefs //
+public:
+    typedef uint64_t result_type;
+
+    ///@brief Odd constant that the counter is multiplied by.
+    static const uint64_t kGamma = 0x9E3779B97F4A7C15ull;
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Starts the stream of (seed, stream) at the first number.
+    CounterRandom(uint64_t seed, uint64_t stream) :
+        m_key    (mix(mix(seed) ^ (stream * kGamma + 1))),
+        m_counter(0)
+    {
+        //Empty...
+    }
+
+
+    // Static Methods //
+public:
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    ///@brief The SplitMix64 finalizer - A bijection of 64 bits values.
+    inline static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+
+    // Public Methods //
+public:
+    ///@brief Gets the next number and moves the counter.
+    inline result_type operator()()
+    {
+        return get(m_counter++);
+    }
+
+    ///@brief Gets the number at counter, without moving the counter.
+    inline result_type get(uint64_t counter) const
+    {
+        return mix(m_key + (counter + 1) * kGamma);
+    }
+
+    ///@brief
+    ///     Gets a number in [0, bound) - bound must be > 0. It's the
+    ///     multiply and shift of Lemire on the high 32 bits of the
+    ///     next numbers, with the few that would bias the low values
+    ///     rejected, so the mapping is fully specified here.
+    inline uint32_t getBounded(uint32_t bound)
+    {
+        auto product = static_cast<uint64_t>((*this)() >> 32) * bound;
+        auto low     = static_cast<uint32_t>(product);
+
+        if(low < bound)
+        {
+            //2^32 % bound - The count of numbers to reject.
+            auto threshold = (0u - bound) % bound;
+            while(low < threshold)
+            {
+                product = static_cast<uint64_t>((*this)() >> 32) * bound;
+                low     = static_cast<uint32_t>(product);
+            }
+        }
+
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    ///@brief Skips the next count numbers.
+    inline void discard(uint64_t count)
+    {
+        m_counter += count;
+    }
+
+
+    ///@brief Gets how many numbers were taken so far.
+    inline uint64_t getCounter() const { return m_counter; }
+
+    ///@brief Sets the counter - The next number is get(counter).
+    inline void setCounter(uint64_t counter) { m_counter = counter; }
+
+
+    // iVars //
+private:
+    uint64_t m_key;
+    uint64_t m_counter;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_CounterRandom_h__) //
@@ -0,0 +1,812 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        FixedGameCore.h                           //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_FixedGameCore_h__
+#define __CorePuzzle15_include_FixedGameCore_h__
+
+//std
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "BoardGenerator.h"
+#include "BoardRenderer.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+#include "Zobrist.h"
+//CoreCoord
+#include "CoreCoord.h"
+//CoreRandom
+#include "CoreRandom.h"
+//CoreGame
+#include "CoreGame.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     GameCore with the Board dimensions fixed at compile time.
+///     It gives the same Boards for the same seed, but the cells
+///     are kept in a std::array and all the index math uses
+///     constant widths - Meant for the small boards (3x3, 4x4, 5x5)
+///     that make most of the games.
+///@note
+///     It has the CTORs and reset() of each Board source (seed,
+///     difficulty and series) and the moving and querying part of
+///     the GameCore API, with the same names and meanings - move(),
+///     moveFast(), tryMove(), getLegalMoves(), the Board, status,
+///     counters and hash getters, snapshot(), restore() and ascii().
+///     It isn't a GameCore subclass, so generic code takes it as a
+///     template parameter.
+///@note
+///     Nothing is allocated after the CTOR and a 4x4 game takes
+///     a single cache line. The random generator is only used to
+///     make the Board, so just it's seed is kept.
+///@note
+///     The neighbors of each cell are in a table that is built at
+///     compile time, and the win check is the tiles in place count
+///     that each move keeps up to date (as GameCore does).
+///@see GameCore.
+template <int W, int H>
+class FixedGameCore
+{
+    static_assert(W > 0 && H > 0,  "Board dimensions must be > 0.");
+    static_assert(W * H <= 65536, "Board is too big for FixedGameCore.");
+
+    // Constants / Enums / Typedefs //
+public:
+    static const int kWidth      = W;
+    static const int kHeight     = H;
+    static const int kCellsCount = W * H;
+
+    typedef GameCore::Board       Board;
+    typedef GameCore::MoveResult  MoveResult;
+    typedef GameCore::MoveSummary MoveSummary;
+    typedef GameCore::Snapshot    Snapshot;
+
+    ///@brief The smallest type that holds all the values.
+    typedef typename std::conditional<
+        (kCellsCount <= 256), uint8_t, uint16_t
+    >::type Cell;
+
+    typedef std::array<Cell, kCellsCount> Cells;
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief
+    ///     Constructs the Game Core for Puzzle 15.
+    ///@param maxMoves Same as GameCore CTOR.
+    ///@param seed     Same as GameCore CTOR.
+    explicit FixedGameCore(int maxMoves = GameCore::kUnlimitedMoves,
+                           int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Constructs the Game Core for Puzzle 15 with a Board
+    ///     inside of the difficulty band.
+    ///@see GameCore CTOR.
+    explicit FixedGameCore(const BoardGenerator::Difficulty &difficulty,
+                           int maxMoves = GameCore::kUnlimitedMoves,
+                           int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Constructs the Game Core for Puzzle 15 with the Board
+    ///     of a series - The same Board of GameCore for it.
+    ///@note The random generator isn't used, getSeed() is 0.
+    ///@see GameCore CTOR.
+    explicit FixedGameCore(const BoardGenerator::Series &series,
+                           int maxMoves = GameCore::kUnlimitedMoves);
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Starts a new game in place - Same as constructing a
+    ///     new FixedGameCore with the same args.
+    ///@see GameCore::reset().
+    void reset(int maxMoves = GameCore::kUnlimitedMoves,
+               int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Same as reset() above, but with a Board inside of the
+    ///     difficulty band (as the CTOR with a difficulty).
+    void reset(const BoardGenerator::Difficulty &difficulty,
+               int maxMoves = GameCore::kUnlimitedMoves,
+               int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Same as reset() above, but with the Board of a
+    ///     series (as the CTOR with a series).
+    void reset(const BoardGenerator::Series &series,
+               int maxMoves = GameCore::kUnlimitedMoves);
+
+    ///@see GameCore::move().
+    MoveResult move(const CoreCoord::Coord &coord);
+
+    ///@see GameCore::move().
+    void move(const CoreCoord::Coord &coord, MoveResult &result);
+
+    ///@see GameCore::moveFast().
+    MoveSummary moveFast(const CoreCoord::Coord &coord);
+
+    ///@see GameCore::tryMove().
+    MoveSummary tryMove(MoveResult::Direction direction);
+
+    ///@see GameCore::getLegalMoves().
+    uint8_t getLegalMoves() const;
+
+    ///@see GameCore::getEmptyValueCoord().
+    const CoreCoord::Coord& getEmptyValueCoord() const;
+
+    ///@brief Gets a copy of Board as nested rows.
+    ///@note Unlike GameCore it's returned by value, no copy is kept.
+    ///@see getCells().
+    Board getBoard() const;
+
+    ///@brief Gets a copy of Board as a FlatBoard.
+    ///@note Unlike GameCore it's returned by value, no copy is kept.
+    ///@see getCells().
+    FlatBoard getFlatBoard() const;
+
+    ///@brief Gets the row-major cells of Board.
+    const Cells& getCells() const;
+
+    ///@see GameCore::getValueAt().
+    int getValueAt(const CoreCoord::Coord &coord) const;
+
+
+    ///@see GameCore::getStatus().
+    CoreGame::Status getStatus() const;
+
+
+    ///@see GameCore::getMovesCount().
+    int getMovesCount() const;
+
+    ///@see GameCore::getMaxMovesCount().
+    int getMaxMovesCount() const;
+
+    ///@see GameCore::getRemainingMovesCount().
+    int getRemainingMovesCount() const;
+
+
+    ///@see GameCore::getCorrectTileCount().
+    int getCorrectTileCount() const;
+
+
+    ///@brief
+    ///     Gets the Zobrist hash of Board - The same of
+    ///     GameCore::getHash() for an equal Board.
+    uint64_t getHash() const;
+
+    ///@see GameCore::snapshot().
+    bool snapshot(Snapshot &snapshot) const;
+
+    ///@brief
+    ///     Sets the game state back to the one saved in snapshot.
+    ///@warning
+    ///     snapshot must be one filled by snapshot() of a game
+    ///     with the same dimensions.
+    void restore(const Snapshot &snapshot);
+
+
+    ///@brief Gets the width of Board.
+    static constexpr int getWidth() { return W; }
+
+    ///@brief Gets the height of Board.
+    static constexpr int getHeight() { return H; }
+
+
+    ///@see GameCore::getSeed().
+    int getSeed() const;
+
+    ///@see GameCore::isUsingRandomSeed().
+    bool isUsingRandomSeed() const;
+
+    ///@see GameCore::ascii().
+    std::string ascii() const;
+
+
+    // Private Types //
+private:
+    //Index of the neighbor cell at each MoveResult::Direction
+    //(Up, Down, Left, Right) or -1 if it's out of Board.
+    struct NeighborTable
+    {
+        int32_t cells[kCellsCount][4];
+    };
+
+    template <int... Indexes>
+    struct IndexList {};
+
+    template <int N, int... Indexes>
+    struct MakeIndexList : MakeIndexList<N -1, N -1, Indexes...> {};
+
+    template <int... Indexes>
+    struct MakeIndexList<0, Indexes...> { typedef IndexList<Indexes...> Type; };
+
+
+    // Private Methods //
+private:
+    static constexpr int32_t getNeighbor(int index, int direction)
+    {
+        return (direction == 0) ? ((index / W > 0    ) ? index - W : -1)
+             : (direction == 1) ? ((index / W < H - 1) ? index + W : -1)
+             : (direction == 2) ? ((index % W > 0    ) ? index - 1 : -1)
+             :                    ((index % W < W - 1) ? index + 1 : -1);
+    }
+
+    template <int... Indexes>
+    static constexpr NeighborTable makeNeighborTable(IndexList<Indexes...>)
+    {
+        return NeighborTable {{
+            { getNeighbor(Indexes, 0), getNeighbor(Indexes, 1),
+              getNeighbor(Indexes, 2), getNeighbor(Indexes, 3) }...
+        }};
+    }
+
+    static CoreCoord::Coord getCoord(int index)
+    {
+        return CoreCoord::Coord(index / W, index % W);
+    }
+
+    void resetState(int maxMoves);
+
+    void initBoard(const BoardGenerator::Difficulty *difficulty, int seed);
+    void initBoard(const BoardGenerator::Series &series);
+    void loadBoard(const FlatBoard &board);
+
+    MoveSummary slide(const CoreCoord::Coord &coord, MoveResult *result);
+    void        shiftTile(int fromIndex, int toIndex);
+
+    void checkStatus();
+    void countCorrectTiles();
+
+
+    // Static Vars //
+private:
+    static const NeighborTable kNeighborTable;
+
+
+    // iVars //
+private:
+    Cells            m_cells;
+    int              m_emptyIndex;
+    CoreCoord::Coord m_emptyCoord;
+
+    CoreGame::Status m_status;
+
+    int m_movesCount;
+    int m_maxMovesCount;
+    int m_correctTilesCount;
+
+    uint64_t m_hash;
+
+    int  m_seed;
+    bool m_usingRandomSeed;
+};
+
+
+// Static Vars //
+template <int W, int H>
+const typename FixedGameCore<W, H>::NeighborTable
+FixedGameCore<W, H>::kNeighborTable = FixedGameCore<W, H>::makeNeighborTable(
+    typename FixedGameCore<W, H>::template MakeIndexList<W * H>::Type()
+);
+
+
+// CTOR/DTOR //
+template <int W, int H>
+FixedGameCore<W, H>::FixedGameCore(int maxMoves, int seed) :
+    //m_cells - Init in initBoard().
+    m_emptyIndex       (0),
+    m_emptyCoord       (-1, -1),
+    m_status           (CoreGame::Status::Continue),
+    m_movesCount       (0),
+    m_maxMovesCount    (maxMoves),
+    m_correctTilesCount(0),
+    m_hash             (0),
+    m_seed             (seed),
+    m_usingRandomSeed  (false)
+{
+    initBoard(nullptr, seed);
+}
+
+template <int W, int H>
+FixedGameCore<W, H>::FixedGameCore(const BoardGenerator::Difficulty &difficulty,
+                                   int maxMoves, int seed) :
+    //m_cells - Init in initBoard().
+    m_emptyIndex       (0),
+    m_emptyCoord       (-1, -1),
+    m_status           (CoreGame::Status::Continue),
+    m_movesCount       (0),
+    m_maxMovesCount    (maxMoves),
+    m_correctTilesCount(0),
+    m_hash             (0),
+    m_seed             (seed),
+    m_usingRandomSeed  (false)
+{
+    initBoard(&difficulty, seed);
+}
+
+template <int W, int H>
+FixedGameCore<W, H>::FixedGameCore(const BoardGenerator::Series &series,
+                                   int maxMoves) :
+    //m_cells - Init in initBoard().
+    m_emptyIndex       (0),
+    m_emptyCoord       (-1, -1),
+    m_status           (CoreGame::Status::Continue),
+    m_movesCount       (0),
+    m_maxMovesCount    (maxMoves),
+    m_correctTilesCount(0),
+    m_hash             (0),
+    m_seed             (0),
+    m_usingRandomSeed  (false)
+{
+    initBoard(series);
+}
+
+
+// Public Methods //
+template <int W, int H>
+void FixedGameCore<W, H>::reset(int maxMoves, int seed)
+{
+    resetState(maxMoves);
+    initBoard(nullptr, seed);
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::reset(const BoardGenerator::Difficulty &difficulty,
+                                int maxMoves, int seed)
+{
+    resetState(maxMoves);
+    initBoard(&difficulty, seed);
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::reset(const BoardGenerator::Series &series,
+                                int maxMoves)
+{
+    resetState(maxMoves);
+    initBoard(series);
+}
+
+template <int W, int H>
+typename FixedGameCore<W, H>::MoveResult
+FixedGameCore<W, H>::move(const CoreCoord::Coord &coord)
+{
+    MoveResult result;
+    slide(coord, &result);
+
+    return result;
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::move(const CoreCoord::Coord &coord,
+                               MoveResult &result)
+{
+    result.moveDirection = MoveResult::Direction::None;
+    result.previousCoords.clear();
+    result.currentCoords.clear();
+
+    slide(coord, &result);
+}
+
+template <int W, int H>
+typename FixedGameCore<W, H>::MoveSummary
+FixedGameCore<W, H>::moveFast(const CoreCoord::Coord &coord)
+{
+    return slide(coord, nullptr);
+}
+
+template <int W, int H>
+typename FixedGameCore<W, H>::MoveSummary
+FixedGameCore<W, H>::tryMove(MoveResult::Direction direction)
+{
+    if(direction == MoveResult::Direction::None)
+        return MoveSummary();
+
+    //There's no tile at that side - Don't do anything...
+    auto index = kNeighborTable.cells[m_emptyIndex][static_cast<int>(direction)];
+    if(index == -1)
+        return MoveSummary();
+
+    return slide(getCoord(index), nullptr);
+}
+
+template <int W, int H>
+uint8_t FixedGameCore<W, H>::getLegalMoves() const
+{
+    if(m_status != CoreGame::Status::Continue)
+        return 0;
+
+    const auto &neighbors = kNeighborTable.cells[m_emptyIndex];
+
+    uint8_t mask = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        if(neighbors[i] != -1)
+            mask |= static_cast<uint8_t>(1 << i);
+    }
+
+    return mask;
+}
+
+template <int W, int H>
+const CoreCoord::Coord& FixedGameCore<W, H>::getEmptyValueCoord() const
+{
+    return m_emptyCoord;
+}
+
+template <int W, int H>
+typename FixedGameCore<W, H>::Board FixedGameCore<W, H>::getBoard() const
+{
+    Board board(H, std::vector<int>(W));
+    for(int i = 0; i < kCellsCount; ++i)
+        board[i / W][i % W] = m_cells[i];
+
+    return board;
+}
+
+template <int W, int H>
+FlatBoard FixedGameCore<W, H>::getFlatBoard() const
+{
+    FlatBoard board(W, H);
+    for(int i = 0; i < kCellsCount; ++i)
+        board.setValueAt(i, m_cells[i]);
+
+    return board;
+}
+
+template <int W, int H>
+const typename FixedGameCore<W, H>::Cells&
+FixedGameCore<W, H>::getCells() const
+{
+    return m_cells;
+}
+
+template <int W, int H>
+int FixedGameCore<W, H>::getValueAt(const CoreCoord::Coord &coord) const
+{
+    return m_cells[coord.y * W + coord.x];
+}
+
+
+template <int W, int H>
+CoreGame::Status FixedGameCore<W, H>::getStatus() const
+{
+    return m_status;
+}
+
+
+template <int W, int H>
+int FixedGameCore<W, H>::getMovesCount() const
+{
+    return m_movesCount;
+}
+
+template <int W, int H>
+int FixedGameCore<W, H>::getMaxMovesCount() const
+{
+    return m_maxMovesCount;
+}
+
+template <int W, int H>
+int FixedGameCore<W, H>::getRemainingMovesCount() const
+{
+    if(m_maxMovesCount == GameCore::kUnlimitedMoves)
+        return GameCore::kUnlimitedMoves;
+
+    return m_maxMovesCount - m_movesCount;
+}
+
+
+template <int W, int H>
+int FixedGameCore<W, H>::getCorrectTileCount() const
+{
+    return m_correctTilesCount;
+}
+
+
+template <int W, int H>
+uint64_t FixedGameCore<W, H>::getHash() const
+{
+    return m_hash;
+}
+
+template <int W, int H>
+bool FixedGameCore<W, H>::snapshot(Snapshot &snapshot) const
+{
+    //Same packing of GameCore::snapshot(), so
+    //the snapshots can be restored by both.
+    if(kCellsCount > Snapshot::kMaxCellsCount)
+        return false;
+
+    snapshot.width         = static_cast<uint8_t>(W);
+    snapshot.height        = static_cast<uint8_t>(H);
+    snapshot.status        = m_status;
+    snapshot.movesCount    = m_movesCount;
+    snapshot.maxMovesCount = m_maxMovesCount;
+    snapshot.seed          = m_seed;
+
+    int bits = 1;
+    while((1 << bits) < kCellsCount)
+        ++bits;
+
+    std::fill(std::begin(snapshot.cells), std::end(snapshot.cells), 0);
+    for(int i = 0; i < kCellsCount; ++i)
+    {
+        auto value = static_cast<uint64_t>(m_cells[i]);
+        auto bit   = i * bits;
+        auto word  = bit / 64;
+        auto shift = bit % 64;
+
+        snapshot.cells[word] |= value << shift;
+        if(shift + bits > 64)
+            snapshot.cells[word + 1] |= value >> (64 - shift);
+    }
+
+    return true;
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::restore(const Snapshot &snapshot)
+{
+    m_status        = snapshot.status;
+    m_movesCount    = snapshot.movesCount;
+    m_maxMovesCount = snapshot.maxMovesCount;
+    m_seed          = snapshot.seed;
+
+    int bits = 1;
+    while((1 << bits) < kCellsCount)
+        ++bits;
+
+    auto mask = (1ull << bits) -1;
+    for(int i = 0; i < kCellsCount; ++i)
+    {
+        auto bit   = i * bits;
+        auto word  = bit / 64;
+        auto shift = bit % 64;
+
+        auto value = snapshot.cells[word] >> shift;
+        if(shift + bits > 64)
+            value |= snapshot.cells[word + 1] << (64 - shift);
+
+        m_cells[i] = static_cast<Cell>(value & mask);
+        if(m_cells[i] == GameCore::kEmptyValue)
+            m_emptyIndex = i;
+    }
+
+    m_emptyCoord = getCoord(m_emptyIndex);
+
+    countCorrectTiles();
+    m_hash = 0;
+    for(int i = 0; i < kCellsCount; ++i)
+        m_hash ^= Zobrist::getKey(m_cells[i], i);
+}
+
+
+template <int W, int H>
+int FixedGameCore<W, H>::getSeed() const
+{
+    return m_seed;
+}
+
+template <int W, int H>
+bool FixedGameCore<W, H>::isUsingRandomSeed() const
+{
+    return m_usingRandomSeed;
+}
+
+template <int W, int H>
+std::string FixedGameCore<W, H>::ascii() const
+{
+    std::string str(BoardRenderer::getAsciiSize(W, H), '\0');
+    BoardRenderer::ascii(m_cells.data(), W, H, &str[0], str.size());
+
+    return str;
+}
+
+
+// Private Methods //
+template <int W, int H>
+void FixedGameCore<W, H>::resetState(int maxMoves)
+{
+    m_status        = CoreGame::Status::Continue;
+    m_movesCount    = 0;
+    m_maxMovesCount = maxMoves;
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::initBoard(const BoardGenerator::Difficulty *difficulty,
+                                    int seed)
+{
+    //Generate exactly as GameCore does, so the same
+    //seed gives the same Board for both.
+    CoreRandom::Random random(seed);
+    FlatBoard          board(W, H);
+
+    auto &rng = random.getNumberGenerator();
+    if(difficulty)
+        BoardGenerator::generate(board, *difficulty, rng);
+    else
+        BoardGenerator::generate(board, rng);
+
+    m_seed            = random.getSeed();
+    m_usingRandomSeed = random.isUsingRandomSeed();
+
+    loadBoard(board);
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::initBoard(const BoardGenerator::Series &series)
+{
+    FlatBoard board(W, H);
+    BoardGenerator::generateSeries(board, series);
+
+    m_seed            = 0;
+    m_usingRandomSeed = false;
+
+    loadBoard(board);
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::loadBoard(const FlatBoard &board)
+{
+    m_hash = 0;
+    for(int i = 0; i < kCellsCount; ++i)
+    {
+        m_cells[i] = static_cast<Cell>(board.getValueAt(i));
+        m_hash    ^= Zobrist::getKey(m_cells[i], i);
+
+        if(m_cells[i] == GameCore::kEmptyValue)
+            m_emptyIndex = i;
+    }
+
+    m_emptyCoord = getCoord(m_emptyIndex);
+    countCorrectTiles();
+}
+
+template <int W, int H>
+typename FixedGameCore<W, H>::MoveSummary
+FixedGameCore<W, H>::slide(const CoreCoord::Coord &coord, MoveResult *result)
+{
+    MoveSummary summary;
+
+    //Game is already over - Don't do anything...
+    if(m_status != CoreGame::Status::Continue)
+        return summary;
+
+    //Coord is the empty coord - Don't do anything...
+    if(m_emptyCoord == coord)
+        return summary;
+
+    //Step (in indexes) from the empty tile toward coord.
+    int step;
+    if(coord.y == m_emptyCoord.y)
+    {
+        step = (coord.x < m_emptyCoord.x) ? -1 : 1;
+        summary.moveDirection = (step < 0) ? MoveResult::Direction::Left
+                                           : MoveResult::Direction::Right;
+    }
+    else if(coord.x == m_emptyCoord.x)
+    {
+        step = (coord.y < m_emptyCoord.y) ? -W : W;
+        summary.moveDirection = (step < 0) ? MoveResult::Direction::Up
+                                           : MoveResult::Direction::Down;
+    }
+    else
+    {
+        //Coord isn't at same row or col from the empty coord.
+        //Cannot move - Don't do anything...
+        return summary;
+    }
+
+    auto targetIndex = coord.y * W + coord.x;
+    for(auto index = m_emptyIndex; index != targetIndex; index += step)
+    {
+        //Only the MoveResult path pays for the coords.
+        if(result)
+        {
+            result->previousCoords.push_back(getCoord(index + step));
+            result->currentCoords.push_back (getCoord(index));
+        }
+
+        shiftTile(index + step, index);
+        ++summary.tilesCount;
+    }
+
+    if(result)
+        result->moveDirection = summary.moveDirection;
+
+    m_emptyIndex = targetIndex;
+    m_emptyCoord = coord;
+
+    ++m_movesCount;
+    checkStatus();
+
+    return summary;
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::shiftTile(int fromIndex, int toIndex)
+{
+    //toIndex is the empty cell - Only the tile
+    //can enter or leave it's place.
+    auto value = m_cells[fromIndex];
+
+    m_hash ^= Zobrist::getSwapDelta(value, fromIndex, GameCore::kEmptyValue, toIndex);
+
+    m_correctTilesCount -= (value == fromIndex + 1);
+    m_correctTilesCount += (value == toIndex   + 1);
+
+    m_cells[toIndex]   = value;
+    m_cells[fromIndex] = GameCore::kEmptyValue;
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::checkStatus()
+{
+    //Player sort all values - Game Won
+    if(m_correctTilesCount == kCellsCount -1)
+    {
+        m_status = CoreGame::Status::Victory;
+        return;
+    }
+
+    //Values aren't sorted, check if player
+    //reach the max moves allowed.
+    if(getRemainingMovesCount() == 0)
+        m_status = CoreGame::Status::Defeat;
+}
+
+template <int W, int H>
+void FixedGameCore<W, H>::countCorrectTiles()
+{
+    //Constant bounds - The compiler unrolls it for the small boards.
+    m_correctTilesCount = 0;
+    for(int i = 0; i < kCellsCount -1; ++i)
+        m_correctTilesCount += (m_cells[i] == i + 1);
+}
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_FixedGameCore_h__) //
@@ -0,0 +1,222 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        FlatBoard.h                               //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_FlatBoard_h__
+#define __CorePuzzle15_include_FlatBoard_h__
+
+//std
+#include <cstdint>
+#include <utility>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+//CoreCoord
+#include "CoreCoord.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Contiguous, row-major storage for the Board values.
+///     Each cell uses the smallest unsigned type that can hold
+///     all the (width * height) values - 1, 2 or 4 bytes - so
+///     the common board sizes fit in a cache line or two.
+///@note
+///     Only one of the cell buffers is used at a time, the one
+///     that matches getCellSize(). Code that needs raw access
+///     should switch on getCellSize() and use getCells<T>().
+class FlatBoard
+{
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs an empty (0x0) board.
+    FlatBoard();
+
+    ///@brief
+    ///     Constructs a board with all cells set to zero.
+    ///@param width  The width of Board - Must be > 0.
+    ///@param height The height of Board - Must be > 0.
+    FlatBoard(int width, int height);
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Changes the dimensions of board and sets all cells to zero.
+    ///     The already allocated memory is reused whenever is possible.
+    ///@param width  The width of Board - Must be > 0.
+    ///@param height The height of Board - Must be > 0.
+    void resize(int width, int height);
+
+
+    ///@brief Gets the width of Board.
+    inline int getWidth() const { return m_width; }
+
+    ///@brief Gets the height of Board.
+    inline int getHeight() const { return m_height; }
+
+    ///@brief Gets the number of cells (width * height) of Board.
+    inline int getCellsCount() const { return m_width * m_height; }
+
+    ///@brief Gets how many bytes each cell takes (1, 2 or 4).
+    inline int getCellSize() const { return m_cellSize; }
+
+
+    ///@brief Gets the row-major index of coord.
+    ///@warning This function will not validate the args.
+    inline int getIndex(const CoreCoord::Coord &coord) const
+    {
+        return coord.y * m_width + coord.x;
+    }
+
+    ///@brief Gets the coord of the row-major index.
+    ///@warning This function will not validate the args.
+    inline CoreCoord::Coord getCoord(int index) const
+    {
+        return CoreCoord::Coord(index / m_width, index % m_width);
+    }
+
+
+    ///@brief Gets the value at index.
+    ///@warning This function will not validate the args.
+    inline int getValueAt(int index) const
+    {
+        switch(m_cellSize)
+        {
+            case 1 : return m_cells8 [index];
+            case 2 : return m_cells16[index];
+            default: return m_cells32[index];
+        }
+    }
+
+    ///@brief Gets the value at coord.
+    ///@warning This function will not validate the args.
+    inline int getValueAt(const CoreCoord::Coord &coord) const
+    {
+        return getValueAt(getIndex(coord));
+    }
+
+    ///@brief Sets the value at index.
+    ///@warning This function will not validate the args.
+    inline void setValueAt(int index, int value)
+    {
+        switch(m_cellSize)
+        {
+            case 1 : m_cells8 [index] = static_cast<uint8_t >(value); break;
+            case 2 : m_cells16[index] = static_cast<uint16_t>(value); break;
+            default: m_cells32[index] = static_cast<uint32_t>(value); break;
+        }
+    }
+
+    ///@brief Swaps the values at index1 and index2.
+    ///@warning This function will not validate the args.
+    inline void swapValuesAt(int index1, int index2)
+    {
+        switch(m_cellSize)
+        {
+            case 1 : std::swap(m_cells8 [index1], m_cells8 [index2]); break;
+            case 2 : std::swap(m_cells16[index1], m_cells16[index2]); break;
+            default: std::swap(m_cells32[index1], m_cells32[index2]); break;
+        }
+    }
+
+
+    ///@brief
+    ///     Gets the raw cells. T must be the type that
+    ///     matches getCellSize() (uint8_t, uint16_t or uint32_t).
+    template <typename T> const T* getCells() const;
+    template <typename T>       T* getCells();
+
+    ///@brief
+    ///     Gets the raw cells as bytes, whatever the cell size is -
+    ///     There are getCellsCount() * getCellSize() of them.
+    inline const uint8_t* getCellsBytes() const
+    {
+        switch(m_cellSize)
+        {
+            case 1 : return m_cells8.data();
+            case 2 : return reinterpret_cast<const uint8_t *>(m_cells16.data());
+            default: return reinterpret_cast<const uint8_t *>(m_cells32.data());
+        }
+    }
+
+    inline uint8_t* getCellsBytes()
+    {
+        return const_cast<uint8_t *>(
+            static_cast<const FlatBoard *>(this)->getCellsBytes()
+        );
+    }
+
+
+    ///@brief
+    ///     Copies the values into the nested vector representation,
+    ///     reusing the memory already allocated by board.
+    void copyTo(std::vector<std::vector<int>> &board) const;
+
+
+    // Static Methods //
+public:
+    ///@brief
+    ///     Gets the bytes of each cell of a Board with cellsCount
+    ///     cells - The smallest that holds (cellsCount - 1).
+    static int cellSizeFor(int cellsCount);
+
+
+    // iVars //
+private:
+    int m_width;
+    int m_height;
+    int m_cellSize;
+
+    std::vector<uint8_t > m_cells8;
+    std::vector<uint16_t> m_cells16;
+    std::vector<uint32_t> m_cells32;
+};
+
+
+template <> inline const uint8_t * FlatBoard::getCells() const { return m_cells8.data (); }
+template <> inline const uint16_t* FlatBoard::getCells() const { return m_cells16.data(); }
+template <> inline const uint32_t* FlatBoard::getCells() const { return m_cells32.data(); }
+template <> inline       uint8_t * FlatBoard::getCells()       { return m_cells8.data (); }
+template <> inline       uint16_t* FlatBoard::getCells()       { return m_cells16.data(); }
+template <> inline       uint32_t* FlatBoard::getCells()       { return m_cells32.data(); }
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_FlatBoard_h__) //
@@ -42,10 +42,17 @@
 #define __CorePuzzle15_include_GameCore_h__
 
 //std
+#include <cstdint>
 #include <string>
 #include <vector>
 //CorePuzzle15
 #include "CorePuzzle15_Utils.h"
+#include "BoardGenerator.h"
+#include "FlatBoard.h"
+#include "Heuristics.h"
+#include "HeuristicsTracker.h"
+#include "MoveTable.h"
+#include "Zobrist.h"
 //CoreCoord
 #include "CoreCoord.h"
 //CoreRandom
@@ -56,6 +63,9 @@
 
 NS_COREPUZZLE15_BEGIN
 
+//Forward declarations.
+class MoveLog;
+
 class GameCore
 {
     // Constants / Enums / Typedefs //
@@ -68,7 +78,11 @@ public:
 
     static const int kEmptyValue;
 
-    ///@brief just to reduce verbosity.
+    ///@brief
+    ///     Nested (row by row) representation of Board.
+    ///     Kept for the existing renderers, the values are
+    ///     actually stored in a FlatBoard.
+    ///@see getBoard(), getFlatBoard().
     typedef std::vector<std::vector<int>> Board;
 
     // Inner Types //
@@ -97,6 +111,99 @@ public:
         CoreCoord::Coord::Vec currentCoords;
     };
 
+    ///@brief
+    ///     What moveFast() and tryMove() return - Just the
+    ///     direction and how many tiles were shifted, so
+    ///     nothing is allocated.
+    struct MoveSummary
+    {
+        //CTOR
+        MoveSummary() :
+            moveDirection(MoveResult::Direction::None),
+            tilesCount   (0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        MoveResult::Direction moveDirection;
+        int                   tilesCount;
+    };
+
+    ///@brief
+    ///     Fixed size copy of the whole game state - The Board is
+    ///     packed with the fewest bits per cell, so a 4x4 Board
+    ///     takes a single 64 bits word.
+    ///@see snapshot(), restore().
+    struct Snapshot
+    {
+        //Constants
+        ///@brief The biggest Board (width * height) that fits.
+        static const int kMaxCellsCount = 64;
+        ///@brief 64 cells of 6 bits.
+        static const int kWordsCount    = 6;
+
+        //CTOR
+        Snapshot() :
+            width        (0),
+            height       (0),
+            status       (CoreGame::Status::Continue),
+            movesCount   (0),
+            maxMovesCount(0),
+            seed         (0),
+            cells        ()
+        {
+            //Empty...
+        }
+
+        //Operators
+        bool operator ==(const Snapshot &other) const;
+        bool operator !=(const Snapshot &other) const;
+
+        //Vars
+        uint8_t          width;
+        uint8_t          height;
+        CoreGame::Status status;
+        int32_t          movesCount;
+        int32_t          maxMovesCount;
+        int32_t          seed;
+        uint64_t         cells[kWordsCount];
+    };
+
+    ///@brief
+    ///     What applyMoves() does with the status of the game.
+    enum class BatchMode {
+        StopAtGameOver, ///< Checks after each move, stops at Victory / Defeat.
+        CheckAtEnd      ///< Checks once after the last move (or at the moves cap).
+    };
+
+    ///@brief What applyMoves() returns - The whole sequence at once.
+    struct BatchResult
+    {
+        //Types
+        enum class StopReason {
+            Completed,   ///< All moves were applied.
+            GameOver,    ///< The game was over before the stop index.
+            InvalidMove  ///< The move at the stop index can't be done.
+        };
+
+        //CTOR
+        BatchResult() :
+            stopReason(StopReason::Completed),
+            stopIndex (0),
+            tilesCount(0),
+            status    (CoreGame::Status::Continue)
+        {
+            //Empty...
+        }
+
+        //Vars
+        StopReason       stopReason;
+        size_t           stopIndex;  ///< First move not applied (count if all were).
+        int              tilesCount; ///< Tiles shifted by all applied moves.
+        CoreGame::Status status;     ///< Status after the last applied move.
+    };
+
 
     // CTOR/DTOR //
 public:
@@ -122,11 +229,214 @@ public:
              int maxMoves = kUnlimitedMoves,
              int seed     = CoreRandom::Random::kRandomSeed);
 
+    ///@brief
+    ///     Constructs the Game Core for Puzzle 15 with a Board
+    ///     which Manhattan distance to the solved Board is
+    ///     inside of the difficulty band.
+    ///     The same seed always gives the same Board.
+    ///@warning
+    ///     The CTOR won't validate any parameters
+    ///     is the caller responsibility to pass valid args.
+    ///@param width      The width of Board - Must be > 0.
+    ///@param height     The height of Board - Must be > 0.
+    ///@param difficulty The band of Manhattan distances.
+    ///@param maxMoves   Same as the other CTOR.
+    ///@param seed       Same as the other CTOR.
+    ///@see BoardGenerator::Difficulty.
+    GameCore(int width,
+             int height,
+             const BoardGenerator::Difficulty &difficulty,
+             int maxMoves = kUnlimitedMoves,
+             int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Constructs the Game Core for Puzzle 15 with the Board
+    ///     at series.index of the series of series.seed - The same
+    ///     Board of PuzzleGenerator::makeSeriesBoard() on any machine.
+    ///@warning
+    ///     The CTOR won't validate any parameters
+    ///     is the caller responsibility to pass valid args.
+    ///@param width    The width of Board - Must be > 0.
+    ///@param height   The height of Board - Must be > 0.
+    ///@param series   The seed and index of the Board.
+    ///@param maxMoves Same as the other CTOR.
+    ///@note The random generator isn't used, getSeed() is 0.
+    ///@see BoardGenerator::Series.
+    GameCore(int width,
+             int height,
+             const BoardGenerator::Series &series,
+             int maxMoves = kUnlimitedMoves);
+
 
     // Public Methods //
 public:
+    ///@brief
+    ///     Starts a new game in place - Same as constructing a new
+    ///     GameCore with the same args, but the memory of this one
+    ///     is reused, so once it held a Board of this size class
+    ///     nothing is allocated.
+    ///@note
+    ///     The undo history is cleared, the MoveLog is unset and the
+    ///     nested Board of getBoard() is dropped (it's built again
+    ///     on the next call, so a reused GameCore doesn't pay to
+    ///     keep it in sync unless it's asked for again).
+    ///@see GameCorePool.
+    void reset(int width,
+               int height,
+               int maxMoves = kUnlimitedMoves,
+               int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Same as reset() above, but with a Board inside of the
+    ///     difficulty band (as the CTOR with a difficulty).
+    void reset(int width,
+               int height,
+               const BoardGenerator::Difficulty &difficulty,
+               int maxMoves = kUnlimitedMoves,
+               int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Same as reset() above, but with the Board of a
+    ///     series (as the CTOR with a series).
+    void reset(int width,
+               int height,
+               const BoardGenerator::Series &series,
+               int maxMoves = kUnlimitedMoves);
+
+    ///@brief
+    ///     Same as reset() above, but the game starts at a copy of
+    ///     board instead of a generated one - As MoveLogReader does
+    ///     with the Board stored in the log.
+    ///@param seed
+    ///     Only kept for getSeed() (and the MoveLog header),
+    ///     the Board isn't made from it.
+    ///@warning board must be solvable, it isn't checked.
+    void reset(const FlatBoard &board,
+               int maxMoves = kUnlimitedMoves,
+               int seed     = 0);
+
+
+    ///@brief
+    ///     Shifts all tiles between coord and the empty tile
+    ///     toward the empty tile. Nothing happens if the game
+    ///     is over or coord isn't in the same row or col of it.
+    ///@param coord The coord of the tile to move.
+    ///@returns The direction and the coords of all shifted tiles.
+    ///@see moveFast(), tryMove().
     MoveResult move(const CoreCoord::Coord &coord);
 
+    ///@brief
+    ///     Same as move(coord) but fills result instead of returning
+    ///     a new one. The vectors of result are cleared but keep their
+    ///     memory, so reusing the same result doesn't allocate.
+    ///@param coord  The coord of the tile to move.
+    ///@param result The result to fill.
+    void move(const CoreCoord::Coord &coord, MoveResult &result);
+
+    ///@brief
+    ///     Same as move(coord) but don't report the shifted coords,
+    ///     so nothing is allocated.
+    ///@param coord The coord of the tile to move.
+    ///@returns The direction and how many tiles were shifted.
+    MoveSummary moveFast(const CoreCoord::Coord &coord);
+
+    ///@brief
+    ///     Moves the single tile that is next to the empty tile
+    ///     at direction - The same meaning of
+    ///     MoveResult::moveDirection. Nothing happens if there's
+    ///     no tile there.
+    ///@param direction The side of the empty tile to take the tile.
+    ///@returns The direction and how many tiles were shifted (0 or 1).
+    MoveSummary tryMove(MoveResult::Direction direction);
+
+    ///@brief
+    ///     Gets the directions that tryMove() can move now - Bit
+    ///     getDirectionBit(direction) is set for each one.
+    ///@returns The mask or 0 if the game is over.
+    ///@note It's a lookup in the MoveTable of the Board size.
+    uint8_t getLegalMoves() const;
+
+    ///@brief Gets the bit of direction in the getLegalMoves() mask.
+    inline static uint8_t getDirectionBit(MoveResult::Direction direction)
+    {
+        return (direction == MoveResult::Direction::None)
+               ? 0
+               : static_cast<uint8_t>(1 << static_cast<int>(direction));
+    }
+
+    ///@brief
+    ///     Applies a sequence of moves in a single call - Each move is
+    ///     validated and applied as moveFast(), but no MoveResult is
+    ///     made and the status is checked as mode says. The sequence
+    ///     stops at the first move that can't be done, or when the
+    ///     game is over.
+    ///@param coords The coords of the tiles to move, in order.
+    ///@param count  How many coords there are.
+    ///@param mode   When the status is checked.
+    ///@returns Where it stopped, why, and the tiles shifted.
+    ///@note
+    ///     The moves are still recorded in the undo history and
+    ///     MoveLog, so undo() takes them back one by one.
+    BatchResult applyMoves(const CoreCoord::Coord *coords,
+                           size_t count,
+                           BatchMode mode = BatchMode::StopAtGameOver);
+
+    ///@brief Same as above for a whole vector.
+    BatchResult applyMoves(const CoreCoord::Coord::Vec &coords,
+                           BatchMode mode = BatchMode::StopAtGameOver);
+
+    ///@brief
+    ///     Same as applyMoves(coords) but each move is the single tile
+    ///     next to the empty tile at the direction (as tryMove()).
+    ///     A direction with no tile there is an invalid move.
+    BatchResult applyMoves(const MoveResult::Direction *directions,
+                           size_t count,
+                           BatchMode mode = BatchMode::StopAtGameOver);
+
+    ///@brief Same as above for a whole vector.
+    BatchResult applyMoves(const std::vector<MoveResult::Direction> &directions,
+                           BatchMode mode = BatchMode::StopAtGameOver);
+
+
+    ///@brief
+    ///     Takes back the last move - The tiles go back, the moves
+    ///     count is decreased and the game continues even if it
+    ///     was over. Each move keeps only the index where the empty
+    ///     tile was, so the history costs 4 bytes per move.
+    ///@returns
+    ///     The direction and how many tiles were shifted, the
+    ///     summary is empty if there's no move to undo.
+    ///@see redo(), canUndo().
+    MoveSummary undo();
+
+    ///@brief
+    ///     Same as undo() but fills result (as move(coord, result))
+    ///     with the coords of the shifted tiles.
+    void undo(MoveResult &result);
+
+    ///@brief
+    ///     Does again the last undone move - Any new move
+    ///     drops the moves that could be redone.
+    ///@returns
+    ///     The direction and how many tiles were shifted, the
+    ///     summary is empty if there's no move to redo.
+    ///@see undo(), canRedo().
+    MoveSummary redo();
+
+    ///@brief
+    ///     Same as redo() but fills result (as move(coord, result))
+    ///     with the coords of the shifted tiles.
+    void redo(MoveResult &result);
+
+    ///@brief Gets if there's a move to undo.
+    bool canUndo() const;
+
+    ///@brief Gets if there's an undone move to redo.
+    bool canRedo() const;
+
+    ///@brief Forgets all moves that could be undone or redone.
+    void clearHistory();
+
     ///@brief Gets the Coord that have the kEmptyValue.
     ///@returns The kEmptyValue Coord.
     ///@see kEmptyValue, getBoard(), getValueAt();
@@ -134,9 +444,24 @@ public:
 
     ///@brief   Gets the game Board.
     ///@returns Reference of the Board.
-    ///@see getValueAt(), getEmptyValueCoord()
+    ///@note
+    ///     This is a compatibility path - The nested Board is built
+    ///     on the first call and from then on each change of the
+    ///     Board keeps it in sync, so the reference is always
+    ///     current until reset() - Call it again after a reset().
+    ///     Prefer getFlatBoard() on hot paths.
+    ///@warning
+    ///     The first call (after the CTOR or a reset()) writes the
+    ///     nested Board, so it isn't safe to race with other readers
+    ///     - Make it before sharing the GameCore between threads.
+    ///@see getFlatBoard(), getValueAt(), getEmptyValueCoord()
     const Board& getBoard() const;
 
+    ///@brief   Gets the game Board as contiguous row-major cells.
+    ///@returns Reference of the FlatBoard.
+    ///@see getBoard(), getValueAt(), getEmptyValueCoord()
+    const FlatBoard& getFlatBoard() const;
+
     ///@brief Gets the value at CoreCoord::Coord.
     ///@param The desired CoreCoord::Coord.
     ///@warning This function will not validate the args.
@@ -173,6 +498,81 @@ public:
     int getRemainingMovesCount() const;
 
 
+    ///@brief
+    ///     Gets how many tiles are in their final place.
+    ///     A tile with value v is in place when it is at the
+    ///     (v - 1) row-major index. kEmptyValue is never counted.
+    ///@returns
+    ///     The number of tiles in place - The game is won
+    ///     when it reaches (width * height) - 1.
+    ///@note This is kept up to date by each move, so it's O(1).
+    int getCorrectTileCount() const;
+
+
+    ///@brief
+    ///     Gets the Zobrist hash of Board - Equal Boards always
+    ///     have the same hash.
+    ///@note This is kept up to date by each move, so it's O(1).
+    ///@see Zobrist.
+    uint64_t getHash() const;
+
+
+    ///@brief
+    ///     Starts (or stops) keeping all Heuristics::Kind up to
+    ///     date on each move, so getHeuristic() is O(1). Each move
+    ///     then pays for the lines that it touched.
+    ///@note It's per game - reset() turns it off, as the CTOR has it.
+    ///@see HeuristicsTracker.
+    void setHeuristicsTracking(bool enabled);
+
+    ///@brief Gets if the heuristics are kept up to date.
+    bool isTrackingHeuristics() const;
+
+    ///@brief
+    ///     Gets how far Board is from the solved one, as kind says.
+    ///     O(1) while tracking, computed from the Board otherwise.
+    ///@returns
+    ///     The value or -1 if the Board size doesn't support kind
+    ///     (WalkingDistance of big Boards).
+    ///@see setHeuristicsTracking(), Heuristics::evaluate().
+    int getHeuristic(Heuristics::Kind kind) const;
+
+    ///@brief
+    ///     Packs the game state (Board, status, moves counters
+    ///     and seed) into snapshot.
+    ///@returns
+    ///     True if the Board fits (Snapshot::kMaxCellsCount),
+    ///     false otherwise - snapshot is untouched then.
+    ///@see restore().
+    bool snapshot(Snapshot &snapshot) const;
+
+    ///@brief
+    ///     Sets the game state back to the one saved in snapshot.
+    ///@note
+    ///     The Board only draws random numbers when it is made,
+    ///     so the seed is all the random state there's to restore.
+    ///     The undo history is cleared and the MoveLog is unset -
+    ///     It's header can't describe the restored Board.
+    ///@warning snapshot must be one filled by snapshot().
+    ///@see snapshot().
+    void restore(const Snapshot &snapshot);
+
+
+    ///@brief
+    ///     Starts recording the moves into moveLog - It's begun
+    ///     with the Board, seed, max moves and difficulty band or
+    ///     series (if any) of the game. Set it right after the CTOR
+    ///     or reset(), so it can be replayed.
+    ///@param moveLog
+    ///     The log or nullptr to stop recording.
+    ///     It must outlive the recording (and the copies of GameCore).
+    ///@see MoveLog, MoveLogReader.
+    void setMoveLog(MoveLog *moveLog);
+
+    ///@brief Gets the log that moves are recorded into or nullptr.
+    MoveLog* getMoveLog() const;
+
+
     ///@brief Gets the width of Board.
     ///@returns The width of Board.
     ///@see getHeight().
@@ -203,26 +603,84 @@ public:
     ///     Intended for debug only.
     std::string ascii() const;
 
+    ///@brief
+    ///     Same as ascii() but sets str, reusing it's memory.
+    ///@see BoardRenderer.
+    void ascii(std::string &str) const;
+
+
+    // Private Types //
+private:
+    //How initBoard() makes the Board.
+    enum class BoardSource {
+        Seed,
+        Difficulty,
+        Series,
+        Given //Copied from the reset() arg.
+    };
+
 
     // Private Methods //
 private:
-    void initBoard(int width, int height);
+    void resetState(int maxMoves, int seed);
+    void initBoard (int width, int height, const FlatBoard *givenBoard = nullptr);
+
+    static int bitsPerCell(int cellsCount);
+
+    MoveSummary slide     (const CoreCoord::Coord &coord, MoveResult *result);
+    MoveSummary commitMove(const CoreCoord::Coord &coord, MoveResult *result);
+    MoveSummary shiftTiles(const CoreCoord::Coord &coord, MoveResult *result);
+
+    template <typename T>
+    BatchResult applyMovesTemplate(const T *moves, size_t count, BatchMode mode);
+
+    bool getMoveCoord(const CoreCoord::Coord &coord,
+                      CoreCoord::Coord &moveCoord) const;
+    bool getMoveCoord(MoveResult::Direction direction,
+                      CoreCoord::Coord &moveCoord) const;
+
+    MoveSummary undo(MoveResult *result);
+    MoveSummary redo(MoveResult *result);
 
     void checkStatus();
-    bool valuesAreSorted();
+    void setStatus(CoreGame::Status status);
+    bool valuesAreSorted() const;
+    void countCorrectTiles();
 
-    void swapValuesAt(const CoreCoord::Coord &coord1,
-                      const CoreCoord::Coord &coord2);
+    template <typename T>
+    void shiftCells(int index, int step);
 
     // iVars //
 private:
-    Board            m_board;
+    FlatBoard        m_board;
     CoreCoord::Coord m_emptyCoord;
+    int              m_emptyIndex;
+    const MoveTable *m_moveTable; //Shared by all GameCores of the size.
+
+    mutable Board m_legacyBoard;
+    mutable bool  m_hasLegacyBoard; //Kept in sync once requested.
 
     CoreGame::Status m_status;
 
     int m_movesCount;
     int m_maxMovesCount;
+    int m_correctTilesCount;
+
+    uint64_t m_hash;
+
+    //How the Board was made, kept for the MoveLog header.
+    BoardSource                m_boardSource;
+    BoardGenerator::Difficulty m_difficulty;
+    BoardGenerator::Series     m_series;
+
+    bool              m_trackHeuristics;
+    HeuristicsTracker m_heuristics;
+
+    MoveLog *m_moveLog;
+
+    //Index of the empty tile before each move.
+    std::vector<int32_t> m_undoIndexes;
+    std::vector<int32_t> m_redoIndexes;
 
     CoreRandom::Random m_random;
 };
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        GameCorePool.h                            //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_GameCorePool_h__
+#define __CorePuzzle15_include_GameCorePool_h__
+
+//std
+#include <cstddef>
+#include <memory>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "BoardGenerator.h"
+#include "GameCore.h"
+//CoreRandom
+#include "CoreRandom.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Recycles GameCore instances - A released GameCore goes to
+///     the free list (arena) of the thread that releases it, and
+///     acquire() takes one from the arena of the calling thread
+///     and starts a new game on it with GameCore::reset().
+///     Once the arenas are warm, opening a game allocates nothing.
+///@note
+///     Each thread only touches it's own arena, so there are no
+///     locks. A GameCore can be acquired in a thread and released
+///     in other, it just moves to the arena of the other one.
+///@note
+///     The arena of a thread is freed when the thread exits.
+class GameCorePool
+{
+    // Inner Types //
+public:
+    ///@brief Gives the GameCore back to the pool.
+    struct Deleter
+    {
+        void operator()(GameCore *core) const;
+    };
+
+    typedef std::unique_ptr<GameCore, Deleter> Pointer;
+
+
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief Default max GameCores kept free in each arena.
+    static const size_t kDefaultMaxFreeCount = 1024;
+
+
+    // Public Methods //
+public:
+    GameCorePool() = delete;
+
+    ///@brief
+    ///     Gets a GameCore with a new game, as it was constructed
+    ///     with the same args.
+    ///@see GameCore CTOR.
+    static Pointer acquire(int width,
+                           int height,
+                           int maxMoves = GameCore::kUnlimitedMoves,
+                           int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Gets a GameCore with a new game inside of the
+    ///     difficulty band, as it was constructed with the same args.
+    ///@see GameCore CTOR.
+    static Pointer acquire(int width,
+                           int height,
+                           const BoardGenerator::Difficulty &difficulty,
+                           int maxMoves = GameCore::kUnlimitedMoves,
+                           int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Gives core to the arena of the calling thread - Same as
+    ///     letting a Pointer go. It's deleted if the arena is full.
+    static void release(GameCore *core);
+
+
+    ///@brief
+    ///     Fills the arena of the calling thread with count GameCores
+    ///     that already have the memory for width x height Boards.
+    static void reserve(size_t count, int width, int height);
+
+    ///@brief Deletes all the free GameCores of the calling thread.
+    static void clear();
+
+    ///@brief Gets how many GameCores are free in the calling thread.
+    static size_t getFreeCount();
+
+    ///@brief
+    ///     Sets how many GameCores the arena of the
+    ///     calling thread keeps - The extra ones are deleted.
+    static void setMaxFreeCount(size_t maxFreeCount);
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_GameCorePool_h__) //
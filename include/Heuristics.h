@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Heuristics.h                              //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_Heuristics_h__
+#define __CorePuzzle15_include_Heuristics_h__
+
+//std
+#include <cstdlib>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Distance metrics between a Board and the solved Board.
+///     On the solved Board the tile with value v is at the
+///     (v - 1) row-major index and the empty tile (value 0)
+///     is at the last index.
+class Heuristics
+{
+    // Constants / Enums / Typedefs //
+public:
+    enum class Kind {
+        Manhattan,       ///< manhattanDistance().
+        LinearConflict,  ///< manhattanDistance() + linearConflict().
+        WalkingDistance  ///< walkingDistance() - Only some sizes.
+    };
+
+
+    // Public Methods //
+public:
+    ///@brief Gets the row-major index where value belongs.
+    ///@param value      The tile value.
+    ///@param cellsCount The number of cells of Board.
+    inline static int getGoalIndex(int value, int cellsCount)
+    {
+        return (value == 0) ? cellsCount - 1 : value - 1;
+    }
+
+    ///@brief
+    ///     Gets the Manhattan distance of the tile value
+    ///     when it is placed at index.
+    ///@note The empty tile (value 0) is always at distance 0.
+    inline static int getTileDistance(int value, int index, int width,
+                                      int cellsCount)
+    {
+        if(value == 0)
+            return 0;
+
+        auto goal = getGoalIndex(value, cellsCount);
+        return std::abs(goal / width - index / width)
+             + std::abs(goal % width - index % width);
+    }
+
+    ///@brief
+    ///     Gets the sum of the Manhattan distances of
+    ///     all tiles (but the empty one) to their goal.
+    static int manhattanDistance(const FlatBoard &board);
+
+    ///@brief
+    ///     Gets the linear conflict penalty of board. Tiles that
+    ///     are in their goal row (or column) but in the wrong order
+    ///     need at least 2 extra moves each to pass one another.
+    ///     Added to manhattanDistance() it's still admissible.
+    static int linearConflict(const FlatBoard &board);
+
+    ///@brief
+    ///     Gets the linear conflict penalty of a single row (or
+    ///     column) of board - linearConflict() is the sum of all.
+    ///@param goals Scratch memory for (at least) the line length.
+    static int rowConflict(const FlatBoard &board, int row, int *goals);
+    static int colConflict(const FlatBoard &board, int col, int *goals);
+
+    ///@brief
+    ///     Gets the walking distance of board - The rows and the
+    ///     columns distances summed.
+    ///@returns
+    ///     The distance or -1 if the size of board has no tables.
+    ///@see WalkingDistance.
+    static int walkingDistance(const FlatBoard &board);
+
+    ///@brief Gets the heuristic kind of board, computed from scratch.
+    ///@returns The value or -1 if board doesn't support kind.
+    static int evaluate(const FlatBoard &board, Kind kind);
+
+    ///@brief
+    ///     Gets the linear conflict penalty of a single line.
+    ///@param goals
+    ///     The goal positions inside the line, in the current order,
+    ///     of the tiles that are in their goal line.
+    ///     It's used as scratch memory, so it's contents are lost.
+    ///@param count The number of goals.
+    ///@returns
+    ///     2 * the number of tiles that must leave the line
+    ///     for the others to be in order.
+    static int lineConflict(int *goals, int count);
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_Heuristics_h__) //
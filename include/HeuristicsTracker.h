@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        HeuristicsTracker.h                       //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_HeuristicsTracker_h__
+#define __CorePuzzle15_include_HeuristicsTracker_h__
+
+//std
+#include <cstdint>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "Heuristics.h"
+#include "WalkingDistance.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Keeps all Heuristics::Kind of a Board up to date as it's
+///     tiles are shifted, so each one is read in O(1).
+///@note
+///     A slide only touches the moved tiles: the Manhattan distance
+///     and the walking distance keys change by a delta of each one,
+///     and only the lines that the tiles went in or out of have their
+///     linear conflict computed again.
+///@see GameCore::getHeuristic().
+class HeuristicsTracker
+{
+    // CTOR/DTOR //
+public:
+    HeuristicsTracker();
+
+
+    // Public Methods //
+public:
+    ///@brief Computes everything from scratch for board.
+    void reset(const FlatBoard &board);
+
+    ///@brief
+    ///     Updates after a slide - The empty tile went from
+    ///     oldEmptyIndex to newEmptyIndex (in the same row or col)
+    ///     and the tiles between were shifted toward oldEmptyIndex.
+    ///@param board The Board after the slide - The one of reset().
+    void update(const FlatBoard &board, int oldEmptyIndex, int newEmptyIndex);
+
+    ///@brief Gets the value of kind.
+    ///@returns The value or -1 if the Board doesn't support kind.
+    int get(Heuristics::Kind kind) const;
+
+
+    // iVars //
+private:
+    int m_width;
+    int m_cellsCount;
+
+    int m_manhattan;
+    int m_conflict;
+
+    std::vector<int> m_rowConflicts;
+    std::vector<int> m_colConflicts;
+    std::vector<int> m_goals; //Scratch of Heuristics::rowConflict().
+
+    //Null if the size has no tables.
+    const WalkingDistance *m_rowsTable;
+    const WalkingDistance *m_colsTable;
+    uint64_t               m_rowsKey;
+    uint64_t               m_colsKey;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_HeuristicsTracker_h__) //
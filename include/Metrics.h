@@ -0,0 +1,230 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Metrics.h                                 //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_Metrics_h__
+#define __CorePuzzle15_include_Metrics_h__
+
+//std
+#include <chrono>
+#include <cstdint>
+#include <string>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Counters and histograms of what GameCore does - Moves made,
+///     moves rejected, tiles shifted per move and checkStatus()
+///     latency. Metrics are only compiled in when the library is
+///     built with __AMAZINGCORE_COREPUZZLE15_METRICS_ENABLED__ -
+///     Otherwise the COREPUZZLE15_METRICS_* points expand to nothing
+///     and GameCore reports nothing.
+///@note
+///     Each thread writes only to it's own storage, with relaxed
+///     atomic loads and stores (no locked instructions), so the
+///     hot path never waits. snapshot() sums the storage of all
+///     threads, the ones that already exited included.
+///@note
+///     Histograms have kBucketsCount power of two buckets - The
+///     bucket i counts the values in (2^(i-1), 2^i], the first one
+///     counts the values <= 1 and the last one all the rest.
+class Metrics
+{
+    // Constants / Enums / Typedefs //
+public:
+    enum class Counter {
+        MovesCount,               ///< Moves that shifted tiles.
+        RejectedGameOverCount,    ///< Moves after Victory / Defeat.
+        RejectedEmptyCoordCount,  ///< Moves at the empty coord.
+        RejectedNotInLineCount,   ///< Coord not in the empty row / col.
+
+        Count
+    };
+
+    enum class Histogram {
+        TilesShifted,             ///< Tiles shifted by each move.
+        CheckStatusNanoseconds,   ///< Time spent in checkStatus().
+
+        Count
+    };
+
+    static const int kCountersCount   = static_cast<int>(Counter  ::Count);
+    static const int kHistogramsCount = static_cast<int>(Histogram::Count);
+    static const int kBucketsCount    = 32;
+
+
+    // Inner Types //
+public:
+    struct HistogramSnapshot
+    {
+        ///@brief Gets the sum of all buckets.
+        uint64_t getCount() const;
+
+        uint64_t buckets[kBucketsCount];
+        uint64_t sum;
+    };
+
+    struct Snapshot
+    {
+        uint64_t getCounter(Counter counter) const
+        {
+            return counters[static_cast<int>(counter)];
+        }
+
+        const HistogramSnapshot& getHistogram(Histogram histogram) const
+        {
+            return histograms[static_cast<int>(histogram)];
+        }
+
+        uint64_t          counters  [kCountersCount];
+        HistogramSnapshot histograms[kHistogramsCount];
+    };
+
+    ///@brief
+    ///     Adds the time from it's construction to it's
+    ///     destruction, in nanoseconds, to histogram.
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Histogram histogram) :
+            m_histogram(histogram),
+            m_start    (std::chrono::steady_clock::now())
+        {
+            //Empty...
+        }
+
+        ~ScopedTimer()
+        {
+            auto elapsed = std::chrono::steady_clock::now() - m_start;
+            Metrics::observe(
+                m_histogram,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    elapsed
+                ).count()
+            );
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer& operator =(const ScopedTimer &) = delete;
+
+    private:
+        Histogram                             m_histogram;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+
+    // Public Methods //
+public:
+    Metrics() = delete;
+
+    ///@brief Gets if the metrics points were compiled in.
+    static constexpr bool isEnabled()
+    {
+    #ifdef __AMAZINGCORE_COREPUZZLE15_METRICS_ENABLED__
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    ///@brief Adds value to the counter of the calling thread.
+    static void add(Counter counter, uint64_t value = 1);
+
+    ///@brief Adds value to the histogram of the calling thread.
+    static void observe(Histogram histogram, uint64_t value);
+
+
+    ///@brief Gets the totals of all threads since the last reset().
+    static Snapshot snapshot();
+
+    ///@brief
+    ///     Gets the snapshot() in the Prometheus text format, with
+    ///     all the names starting with prefix - e.g:
+    ///       corepuzzle15_moves_total 42
+    static std::string prometheus(const std::string &prefix = "corepuzzle15");
+
+    ///@brief
+    ///     Makes the next snapshots start from zero - The threads'
+    ///     storage isn't touched, the current totals are just
+    ///     subtracted from the next snapshots.
+    static void reset();
+
+
+    ///@brief Gets the bucket that value goes.
+    static int getBucketIndex(uint64_t value);
+
+    ///@brief
+    ///     Gets the upper bound of the bucket index, i.e. 2^index.
+    ///     The last bucket has no bound (UINT64_MAX).
+    static uint64_t getBucketBound(int index);
+};
+
+NS_COREPUZZLE15_END
+
+
+//Metrics points, e.g.
+//  COREPUZZLE15_METRICS_ADD    (MovesCount);
+//  COREPUZZLE15_METRICS_OBSERVE(TilesShifted, summary.tilesCount);
+//  COREPUZZLE15_METRICS_TIME   (CheckStatusNanoseconds);
+//The last one times until the end of the enclosing scope.
+#ifdef __AMAZINGCORE_COREPUZZLE15_METRICS_ENABLED__
+    #define COREPUZZLE15_METRICS_ADD(_counter_)                          \
+        CorePuzzle15::Metrics::add(                                      \
+            CorePuzzle15::Metrics::Counter::_counter_                    \
+        )
+
+    #define COREPUZZLE15_METRICS_OBSERVE(_histogram_, _value_)           \
+        CorePuzzle15::Metrics::observe(                                  \
+            CorePuzzle15::Metrics::Histogram::_histogram_, (_value_)     \
+        )
+
+    #define COREPUZZLE15_METRICS_TIME(_histogram_)                       \
+        CorePuzzle15::Metrics::ScopedTimer _metricsTimer_##_histogram_(  \
+            CorePuzzle15::Metrics::Histogram::_histogram_                \
+        )
+#else
+    #define COREPUZZLE15_METRICS_ADD(_counter_)                do {} while(0)
+    #define COREPUZZLE15_METRICS_OBSERVE(_histogram_, _value_) do {} while(0)
+    #define COREPUZZLE15_METRICS_TIME(_histogram_)             do {} while(0)
+#endif
+
+#endif // defined(__CorePuzzle15_include_Metrics_h__) //
@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MoveLog.h                                 //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_MoveLog_h__
+#define __CorePuzzle15_include_MoveLog_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Records the moves of a game in a compact binary log that
+///     MoveLogReader can replay. Set it in a GameCore with
+///     GameCore::setMoveLog() and every move is appended.
+///@note
+///     File layout:
+///       - Magic "CP15LOG" and a version byte.
+///       - Header varints: width, height, seed, maxMoves
+///         (seed and maxMoves zigzag encoded, they can be < 0)
+///         and how the Board was made from the seed:
+///         kSeedBoard       - Shuffled, as GameCore(w, h, max, seed).
+///         kDifficultyBoard - Inside of a band, followed by the min
+///                            and max distances (zigzag encoded).
+///         kSeriesBoard     - Of a series, followed by the series
+///                            seed and index (the seed above is 0).
+///         Version 1 logs have no Board code, they're all kSeedBoard.
+///       - Since version 3, kSeedBoard and kDifficultyBoard are
+///         followed by the width * height starting cells (varints,
+///         row-major) - The shuffle of a seed goes through the std
+///         distributions, that each standard library maps in it's
+///         own way, so only the cells replay the same everywhere.
+///         Series Boards are the same everywhere already.
+///       - Runs of moves, each starting with a varint count:
+///         count > 0 - count single tile moves, 2 bits each
+///                     (4 per byte) with the Direction value.
+///         count = 0 - Escape followed by a code byte:
+///                     0 to 3 - A slide of many tiles, the code is
+///                              the Direction and a varint tilesCount
+///                              comes after it.
+///                     4 / 5  - GameCore::undo() / GameCore::redo().
+///@note
+///     The single tile moves are kept in a pending run until the
+///     run is full, a slide comes or flush() is called - So a
+///     long game of single moves costs ~2 bits per move.
+class MoveLog
+{
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief The max single tile moves of a run.
+    static const int kMaxRunLength = 4096;
+
+    ///@brief The version written in the header.
+    static const uint8_t kVersion = 3;
+
+    ///@brief The magic bytes that start every log.
+    static const char kMagic[7];
+
+    ///@brief Escape codes of undo() and redo().
+    static const uint8_t kUndoCode = 4;
+    static const uint8_t kRedoCode = 5;
+
+    ///@brief Header codes of how the Board was made.
+    static const uint8_t kSeedBoard       = 0;
+    static const uint8_t kDifficultyBoard = 1;
+    static const uint8_t kSeriesBoard     = 2;
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs an empty log - begin() must be called first.
+    MoveLog();
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Clears the log and writes the header, with the cells of
+    ///     board - It must be begun with the Board and the values
+    ///     of the game CTOR, before any move.
+    ///@note GameCore::setMoveLog() calls it.
+    void begin(const FlatBoard &board, int seed, int maxMoves);
+
+    ///@brief
+    ///     Same as begin() above for a game whose Board was made
+    ///     inside of the difficulty band.
+    void begin(const FlatBoard &board,
+               const BoardGenerator::Difficulty &difficulty,
+               int seed, int maxMoves);
+
+    ///@brief
+    ///     Same as begin() above for a game whose Board
+    ///     is the one of a series.
+    void begin(int width, int height,
+               const BoardGenerator::Series &series,
+               int maxMoves);
+
+    ///@brief
+    ///     Appends a move of tilesCount tiles toward direction.
+    ///     Nothing is recorded for tilesCount < 1.
+    void record(GameCore::MoveResult::Direction direction, int tilesCount);
+
+    ///@brief Appends an undo of the last move.
+    void recordUndo();
+
+    ///@brief Appends a redo of the last undone move.
+    void recordRedo();
+
+    ///@brief Writes the pending run of single tile moves.
+    void flush();
+
+    ///@brief Gets how many moves (undo and redo too) were recorded.
+    int getMovesCount() const;
+
+    ///@brief
+    ///     Gets the log bytes.
+    ///@warning Moves of the pending run are only there after flush().
+    const std::vector<uint8_t>& getData() const;
+
+    ///@brief Flushes and writes the log into path.
+    ///@returns True if the file was written, false otherwise.
+    bool save(const std::string &path);
+
+
+    // Static Methods //
+public:
+    ///@brief Appends value as an unsigned LEB128 varint.
+    static void writeVarint(std::vector<uint8_t> &data, uint64_t value);
+
+    ///@brief
+    ///     Reads an unsigned LEB128 varint at offset (moved past it).
+    ///@returns False if the data ends before the varint.
+    static bool readVarint(const uint8_t *data, size_t size,
+                           size_t &offset, uint64_t &value);
+
+
+    // Private Methods //
+private:
+    void writeHeader(int width, int height, int seed, int maxMoves,
+                     uint8_t boardCode);
+    void writeCells (const FlatBoard &board);
+    void recordEscape(uint8_t code);
+
+
+    // iVars //
+private:
+    std::vector<uint8_t> m_data;
+    std::vector<uint8_t> m_run;
+    int                  m_runLength;
+    int                  m_movesCount;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_MoveLog_h__) //
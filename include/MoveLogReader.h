@@ -0,0 +1,214 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MoveLogReader.h                           //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_MoveLogReader_h__
+#define __CorePuzzle15_include_MoveLogReader_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "GameCore.h"
+#include "MoveLog.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Reads the logs written by MoveLog one move at a time,
+///     straight from memory - Nothing is copied or allocated,
+///     so a mapped file (load()) can be replayed in place.
+///@see MoveLog for the layout.
+class MoveLogReader
+{
+    // Inner Types //
+public:
+    struct Entry
+    {
+        //Types
+        enum class Type {
+            Move,  ///< direction and tilesCount are set.
+            Undo,
+            Redo
+        };
+
+        //CTOR
+        Entry() :
+            type      (Type::Move),
+            direction (GameCore::MoveResult::Direction::None),
+            tilesCount(0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        Type                            type;
+        GameCore::MoveResult::Direction direction;
+        int                             tilesCount;
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs a reader with no log.
+    MoveLogReader();
+    ~MoveLogReader();
+
+    MoveLogReader(const MoveLogReader &) = delete;
+    MoveLogReader& operator =(const MoveLogReader &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Reads the header of the log in data.
+    ///     data must stay valid while it's being read.
+    ///@returns True if it's a valid header, false otherwise.
+    bool open(const uint8_t *data, size_t size);
+
+    ///@brief Maps the log file at path (mmap) and reads it's header.
+    ///@returns True if it's a valid log, false otherwise.
+    bool load(const std::string &path);
+
+    ///@brief Unmaps the file or forgets the data - Safe to call always.
+    void close();
+
+    ///@brief Gets if there's a log with a valid header.
+    bool isOpen() const;
+
+    ///@brief Gets if the moves data was found broken.
+    bool hasError() const;
+
+
+    int getWidth   () const;
+    int getHeight  () const;
+    int getSeed    () const;
+    int getMaxMoves() const;
+
+    ///@brief Gets if the Board of the game was made inside of a band.
+    bool hasDifficulty() const;
+
+    ///@brief Gets the band of the Board - Only if hasDifficulty().
+    const BoardGenerator::Difficulty& getDifficulty() const;
+
+    ///@brief Gets if the Board of the game is the one of a series.
+    bool hasSeries() const;
+
+    ///@brief Gets the series of the Board - Only if hasSeries().
+    const BoardGenerator::Series& getSeries() const;
+
+    ///@brief
+    ///     Gets if the log has the starting cells of the Board
+    ///     (version 3 logs of seed and difficulty Boards).
+    bool hasBoard() const;
+
+    ///@brief
+    ///     Copies the starting Board of the log into board (it's
+    ///     resized to getWidth() x getHeight()) - Only if hasBoard().
+    void getBoard(FlatBoard &board) const;
+
+    ///@brief
+    ///     Resets core to the game that the log starts at, i.e:
+    ///       core.reset(board, getMaxMoves(), getSeed());
+    ///     with the getBoard() if the log has it - So it's the same
+    ///     game with any standard library. Older logs make it again,
+    ///     with the reset() of getSeries() / getDifficulty() / the
+    ///     seed - The seed ones are only the same Board with the
+    ///     standard library that wrote them.
+    void initCore(GameCore &core) const;
+
+
+    ///@brief
+    ///     Reads the next entry (move, undo or redo).
+    ///@returns False at the end of the log or if it's broken.
+    ///@see hasError().
+    bool next(Entry &entry);
+
+    ///@brief Goes back to the first move.
+    void rewind();
+
+    ///@brief
+    ///     Applies all entries not read yet to core (moves with
+    ///     moveFast(), so no MoveResult is made, and the undo / redo
+    ///     ones with GameCore::undo() / GameCore::redo()).
+    ///     core must be at the start of the game of the log, as
+    ///     initCore() sets it.
+    ///@returns
+    ///     The number of entries applied, or -1 if the log is broken or
+    ///     a move goes out of the Board (core keeps the ones before).
+    int replay(GameCore &core);
+
+
+    // Private Methods //
+private:
+    bool readHeader();
+
+
+    // iVars //
+private:
+    void   *m_mapping;
+    size_t  m_mappingSize;
+
+    const uint8_t *m_data;
+    size_t         m_size;
+    size_t         m_movesOffset;
+    size_t         m_offset;
+    bool           m_error;
+
+    int m_width;
+    int m_height;
+    int m_seed;
+    int m_maxMoves;
+
+    uint8_t                    m_boardCode; //MoveLog::kSeedBoard...
+    size_t                     m_cellsOffset; //0 if there are no cells.
+    BoardGenerator::Difficulty m_difficulty;
+    BoardGenerator::Series     m_series;
+
+    //Run being read.
+    size_t m_runOffset;
+    int    m_runLength;
+    int    m_runIndex;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_MoveLogReader_h__) //
@@ -0,0 +1,259 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MovePipeline.h                            //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_MovePipeline_h__
+#define __CorePuzzle15_include_MovePipeline_h__
+
+//std
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "GameCore.h"
+//CoreCoord
+#include "CoreCoord.h"
+//CoreGame
+#include "CoreGame.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Moves GameCores on worker threads, so the threads that
+///     get the moves (the network ones) never touch a Board.
+///     move() only puts the move in the ring buffer of the Board
+///     and the result comes later by a callback or a future.
+///@note
+///     When a Board gets moves, it goes to the ready queue of it's
+///     worker (always the same one). The worker takes up to
+///     Options::maxBatchSize moves at once and applies them with
+///     GameCore::applyMoves() - By default the status is checked
+///     after each move (GameCore::BatchMode::StopAtGameOver), so
+///     the Outcomes are the same as moving one by one.
+///@note
+///     The results of a Board are given in the order of it's moves,
+///     in the worker thread - Keep the callbacks short.
+///@warning
+///     Options::batchMode = CheckAtEnd is faster but the Outcomes
+///     depend on how the moves were batched - Moves after a Victory
+///     in the same batch are still applied (and given as Moved),
+///     while in the next batch they'd be GameOver.
+///@warning
+///     Each ring buffer has a single producer - The moves of a Board
+///     must be queued by one thread at a time. An attached GameCore
+///     must not be touched by others until flush() or detach().
+class MovePipeline
+{
+    // Constants / Enums / Typedefs //
+public:
+    typedef int BoardId;
+
+    ///@brief Given by attach() when there's no room.
+    static const BoardId kInvalidBoardId = -1;
+
+
+    // Inner Types //
+public:
+    struct Options
+    {
+        //CTOR
+        Options() :
+            threadsCount  (1),
+            maxBoardsCount(1024),
+            queueCapacity (256),
+            maxBatchSize  (64),
+            batchMode     (GameCore::BatchMode::StopAtGameOver)
+        {
+            //Empty...
+        }
+
+        //Vars
+        int                 threadsCount;   ///< 0 uses one per hardware thread.
+        int                 maxBoardsCount; ///< Boards attached at once.
+        int                 queueCapacity;  ///< Moves waiting for each Board (rounded up to a power of 2).
+        int                 maxBatchSize;   ///< Moves applied at once.
+        GameCore::BatchMode batchMode;      ///< How often the status is checked - CheckAtEnd is opt-in (see the warning above).
+    };
+
+    struct Outcome
+    {
+        //Types
+        enum class Status {
+            Moved,     ///< summary has the move.
+            Invalid,   ///< The tile can't move.
+            GameOver,  ///< The game was already over.
+            QueueFull, ///< Dropped - The Board had too many moves waiting.
+            NoBoard    ///< Dropped - The BoardId isn't attached.
+        };
+
+        //CTOR
+        Outcome() :
+            status    (Status::NoBoard),
+            gameStatus(CoreGame::Status::Continue),
+            movesCount(0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        Status                status;
+        GameCore::MoveSummary summary;
+        CoreGame::Status      gameStatus; ///< After the batch of the move.
+        int                   movesCount; ///< After the batch of the move.
+    };
+
+    typedef std::function<void (const Outcome &outcome)> Callback;
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs the pipeline and starts it's threads.
+    explicit MovePipeline(const Options &options = Options());
+
+    ///@brief Applies all queued moves, then stops the threads.
+    ~MovePipeline();
+
+    MovePipeline(const MovePipeline &) = delete;
+    MovePipeline& operator =(const MovePipeline &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Starts moving core in the pipeline.
+    ///@returns
+    ///     The id to queue moves with or kInvalidBoardId
+    ///     if there are Options::maxBoardsCount Boards already.
+    ///@warning core must outlive the attachment.
+    BoardId attach(GameCore &core);
+
+    ///@brief Waits for the moves of board, then forgets it.
+    void detach(BoardId board);
+
+    ///@brief Waits until all moves queued for board are applied.
+    void flush(BoardId board);
+
+
+    ///@brief
+    ///     Queues the move of the tile at coord - callback is called
+    ///     with the Outcome (by a worker) once it's applied.
+    ///@returns
+    ///     False if the move was dropped (Outcome::Status::QueueFull
+    ///     or NoBoard) - callback is never called then.
+    bool move(BoardId board,
+              const CoreCoord::Coord &coord,
+              const Callback &callback);
+
+    ///@brief
+    ///     Same as above, but the Outcome comes in a future - A
+    ///     dropped move gives a future that is already set.
+    std::future<Outcome> move(BoardId board, const CoreCoord::Coord &coord);
+
+
+    ///@brief Gets how many threads apply the moves.
+    int getThreadsCount() const;
+
+    ///@brief Gets the options given to the CTOR.
+    const Options& getOptions() const;
+
+
+    // Private Types //
+private:
+    struct Request
+    {
+        CoreCoord::Coord coord;
+        Callback         callback;
+    };
+
+    //Single producer / single consumer ring of Requests.
+    struct Channel
+    {
+        std::atomic<GameCore *> core;      //nullptr while not attached.
+        std::vector<Request>    requests;
+        std::atomic<size_t>     head;      //Next to apply - The worker moves it.
+        std::atomic<size_t>     tail;      //Next to queue - The producer moves it.
+        std::atomic<bool>       scheduled; //In the ready queue or being drained.
+    };
+
+    struct Worker
+    {
+        std::mutex              mutex;
+        std::condition_variable condition;
+        std::deque<BoardId>     ready;
+        std::thread             thread;
+    };
+
+
+    // Private Methods //
+private:
+    void workerLoop(int workerIndex);
+    void schedule  (BoardId board);
+    void drain     (BoardId board, int workerIndex);
+
+    Channel* getChannel(BoardId board);
+
+
+    // iVars //
+private:
+    Options                    m_options;
+    int                        m_threadsCount;
+    size_t                     m_queueMask;
+    std::unique_ptr<Channel[]> m_channels;
+    std::unique_ptr<Worker[]>  m_workers;
+
+    std::mutex           m_boardsMutex; //attach() / detach().
+    std::vector<BoardId> m_freeBoards;
+    std::atomic<bool>    m_quit;
+
+    //Scratch of each worker.
+    std::vector<CoreCoord::Coord::Vec> m_coords;
+    std::vector<std::vector<Outcome>>  m_outcomes;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_MovePipeline_h__) //
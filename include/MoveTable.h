@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MoveTable.h                               //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_MoveTable_h__
+#define __CorePuzzle15_include_MoveTable_h__
+
+//std
+#include <cstdint>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+//CoreCoord
+#include "CoreCoord.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Everything about the cells of a Board size that moves need
+///     - The row and col of each index, the neighbor at each side
+///     and the mask of the sides that have one - So a move never
+///     divides or compares coords to find them.
+///@note
+///     The directions are the indexes of GameCore::MoveResult::Direction
+///     (Up, Down, Left, Right), as in the table of FixedGameCore.
+///@note
+///     A table is built on the first get() of it's size and shared
+///     by all GameCores (and threads) - get() is thread safe. Only
+///     the first get() of a size locks, after that sizes up to
+///     16 x 16 are a single atomic load (bigger ones still lock).
+class MoveTable
+{
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief The neighbor of the cells at the border of Board.
+    static const int kNoNeighbor = -1;
+
+    ///@brief The 4 sides - Up, Down, Left and Right.
+    static const int kDirectionsCount = 4;
+
+
+    // CTOR/DTOR //
+public:
+    MoveTable(const MoveTable &) = delete;
+    MoveTable& operator =(const MoveTable &) = delete;
+
+private:
+    MoveTable(int width, int height);
+
+
+    // Static Methods //
+public:
+    ///@brief
+    ///     Gets the shared table of width x height Boards
+    ///     - It's built on the first call.
+    static const MoveTable& get(int width, int height);
+
+
+    // Public Methods //
+public:
+    ///@brief Gets the width of Board.
+    inline int getWidth() const { return m_width; }
+
+    ///@brief Gets the height of Board.
+    inline int getHeight() const { return m_height; }
+
+
+    ///@brief Gets the row (y) of index.
+    inline int getRow(int index) const { return m_rows[index]; }
+
+    ///@brief Gets the col (x) of index.
+    inline int getCol(int index) const { return m_cols[index]; }
+
+    ///@brief Gets the coord of index.
+    inline CoreCoord::Coord getCoord(int index) const
+    {
+        return CoreCoord::Coord(m_rows[index], m_cols[index]);
+    }
+
+
+    ///@brief
+    ///     Gets the index of the cell next to index at
+    ///     direction or kNoNeighbor if it's out of Board.
+    inline int getNeighbor(int index, int direction) const
+    {
+        return m_neighbors[index * kDirectionsCount + direction];
+    }
+
+    ///@brief
+    ///     Gets the directions that have a neighbor of index
+    ///     - Bit (1 << direction) is set for each one.
+    inline uint8_t getNeighborsMask(int index) const
+    {
+        return m_neighborsMasks[index];
+    }
+
+
+    // iVars //
+private:
+    int m_width;
+    int m_height;
+
+    std::vector<int32_t> m_rows;
+    std::vector<int32_t> m_cols;
+    std::vector<int32_t> m_neighbors;      //[index * 4 + direction]
+    std::vector<uint8_t> m_neighborsMasks; //[index]
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_MoveTable_h__) //
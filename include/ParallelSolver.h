@@ -0,0 +1,188 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        ParallelSolver.h                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_ParallelSolver_h__
+#define __CorePuzzle15_include_ParallelSolver_h__
+
+//std
+#include <chrono>
+#include <cstdint>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+#include "PatternDatabase.h"
+#include "ReductionSolver.h"
+#include "Solver.h"
+//CoreCoord
+#include "CoreCoord.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Solves on a pool of threads, within a deadline.
+///@note
+///     Optimal solutions are found by IDA* (the one of Solver) - For
+///     each bound, the first levels of the search tree are expanded
+///     until there are kTasksPerThread nodes for each thread. Each
+///     thread has a queue of them and takes the work of the others
+///     when it's own runs out. The next bound and the stop flag are
+///     shared by atomics only.
+///@note
+///     Suboptimal solutions are found by ReductionSolver, in about
+///     a millisecond for 16x16 Boards. In Mode::Anytime that one is
+///     kept while IDA* looks for a shorter one until the deadline.
+///@note
+///     Each thread keeps it's own Solver between calls, so a
+///     ParallelSolver must not be used by many threads at once.
+class ParallelSolver
+{
+    // Constants / Enums / Typedefs //
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum class Mode {
+        Optimal, ///< IDA* only - Up to Solver::kMaxCellsCount.
+        Anytime, ///< ReductionSolver, then IDA* until the deadline.
+        Fast     ///< ReductionSolver only - Any size.
+    };
+
+    ///@brief Nodes for each thread that IDA* splits the tree into.
+    static const int kTasksPerThread = 32;
+
+
+    // Inner Types //
+public:
+    struct Options
+    {
+        //CTOR
+        Options() :
+            mode        (Mode::Anytime),
+            threadsCount(0),
+            database    (nullptr)
+        {
+            //Empty...
+        }
+
+        //Vars
+        Mode                   mode;
+        int                    threadsCount; ///< 0 uses one per hardware thread.
+        const PatternDatabase *database;     ///< Optional, for IDA*.
+    };
+
+    struct Result
+    {
+        //Types
+        enum class Status {
+            Optimal,     ///< moves has an optimal solution.
+            Suboptimal,  ///< moves has a solution, maybe not the shortest.
+            Timeout,     ///< Nothing was found before the deadline.
+            Unsolvable,  ///< Board can't be solved at all.
+            Unsupported  ///< Board is too big for the mode.
+        };
+
+        //CTOR
+        Result() :
+            status       (Status::Unsupported),
+            expandedNodes(0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        Status   status;
+        uint64_t expandedNodes; ///< By IDA*, in all threads.
+
+        ///@brief
+        ///     The coords of the tiles to move, in order.
+        ///     Each one can be passed straight to GameCore::move().
+        CoreCoord::Coord::Vec moves;
+    };
+
+
+    // CTOR/DTOR //
+public:
+    explicit ParallelSolver(const Options &options = Options());
+
+
+    // Public Methods //
+public:
+    ///@brief Finds a solution for the current Board of core.
+    ///@param deadline When to give back the best solution found.
+    ///@warning
+    ///     Mode::Anytime only stops at the deadline (or when it knows
+    ///     the solution is optimal) - Give it one for big Boards.
+    Result solve(const GameCore &core,
+                 const Clock::time_point &deadline = Clock::time_point::max());
+
+    ///@brief Finds a solution for board.
+    Result solve(const FlatBoard &board,
+                 const Clock::time_point &deadline = Clock::time_point::max());
+
+
+    ///@brief Gets the options given to the CTOR.
+    const Options& getOptions() const;
+
+
+    // Private Methods //
+private:
+    Result::Status searchOptimal(const FlatBoard &board,
+                                 const Clock::time_point &deadline,
+                                 int knownLength,
+                                 std::vector<int> &path,
+                                 uint64_t &expandedNodes);
+
+    bool expandFrontier(int bound, int &nextBound,
+                        std::vector<std::vector<int>> &tasks,
+                        std::vector<int> &path,
+                        uint64_t &expandedNodes);
+
+    // iVars //
+private:
+    Options             m_options;
+    int                 m_threadsCount;
+    std::vector<Solver> m_solvers; //One per thread - [0] does the frontier.
+    ReductionSolver     m_reduction;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_ParallelSolver_h__) //
@@ -0,0 +1,196 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PatternDatabase.h                         //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_PatternDatabase_h__
+#define __CorePuzzle15_include_PatternDatabase_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Additive pattern databases - For each group (pattern) of
+///     tiles, a table with the least number of moves of those tiles
+///     needed to put them in place, for every placement of them.
+///     The tables of disjoint patterns can be summed and the result
+///     still never overestimates the real solution length.
+///@note
+///     The tables are built once with build() and saved to disk.
+///     load() maps the file read only (mmap), so many processes
+///     share one copy in the page cache and there's no rebuild cost.
+///@note
+///     Each entry takes a nibble: it holds how much (in pairs of
+///     moves) the pattern cost is above the Manhattan distance of
+///     the pattern tiles - The difference is always even.
+///     Differences above 30 are clamped, which keeps them admissible.
+///@note
+///     While building, the other tiles are all alike - The empty
+///     tile moves for free among them and only the moves of the
+///     pattern tiles are counted, so the tables stay additive.
+class PatternDatabase
+{
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief The max number of patterns in a database.
+    static const int kMaxPatternsCount = 8;
+
+    ///@brief The max number of tiles in a pattern.
+    static const int kMaxPatternTilesCount = 8;
+
+    ///@brief The biggest Board (width * height) that is supported.
+    static const int kMaxCellsCount = 32;
+
+    ///@brief Each pattern is the list of it's tile values.
+    typedef std::vector<std::vector<int>> Patterns;
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs an empty (not loaded) database.
+    PatternDatabase();
+    ~PatternDatabase();
+
+    PatternDatabase(const PatternDatabase &) = delete;
+    PatternDatabase& operator =(const PatternDatabase &) = delete;
+
+
+    // Static Methods //
+public:
+    ///@brief
+    ///     Gets the default partition of tiles for the Board size:
+    ///     6-6-3 for 4x4 and 6-6-6-6 for 5x5.
+    ///@returns The patterns or an empty list if there's no default.
+    static Patterns getDefaultPatterns(int width, int height);
+
+    ///@brief
+    ///     Builds the tables of patterns and writes them into path.
+    ///@param width    The width of Board.
+    ///@param height   The height of Board.
+    ///@param patterns
+    ///     Disjoint groups of tile values - Tiles left out of all
+    ///     groups count only their Manhattan distance.
+    ///@param path     The file to write.
+    ///@returns True if the file was written, false otherwise.
+    ///@warning
+    ///     The build takes five bytes per pattern placement while it
+    ///     runs - ~640MB for the 6 tiles patterns of a 5x5 Board.
+    static bool build(int width, int height,
+                      const Patterns &patterns,
+                      const std::string &path);
+
+    ///@brief
+    ///     Gets the rank (table index) of a placement of tilesCount
+    ///     tiles - positions[i] is the cell of the i-th tile.
+    static uint64_t rank(const uint8_t *positions, int tilesCount,
+                         int cellsCount);
+
+
+    // Public Methods //
+public:
+    ///@brief Maps the database file at path.
+    ///@returns
+    ///     True if the file is a valid database, false otherwise -
+    ///     Each tile must be inside of Board and in a single pattern.
+    bool load(const std::string &path);
+
+    ///@brief Unmaps the database file - Safe to call if not loaded.
+    void unload();
+
+    ///@brief Gets if a database file is mapped.
+    bool isLoaded() const;
+
+
+    ///@brief Gets the width of Board the database was built for.
+    int getWidth() const;
+
+    ///@brief Gets the height of Board the database was built for.
+    int getHeight() const;
+
+    ///@brief Gets the number of patterns.
+    int getPatternsCount() const;
+
+    ///@brief Gets the number of tiles of the pattern.
+    int getPatternTilesCount(int pattern) const;
+
+    ///@brief Gets the value of the index-th tile of the pattern.
+    int getPatternTile(int pattern, int index) const;
+
+
+    ///@brief
+    ///     Gets the stored entry of the pattern for the rank, i.e.
+    ///     (pattern cost - pattern Manhattan distance) / 2.
+    ///@warning This function will not validate the args.
+    inline int getEntry(int pattern, uint64_t rank) const
+    {
+        auto byte = m_tables[pattern][rank >> 1];
+        return (rank & 1) ? (byte >> 4) : (byte & 0x0F);
+    }
+
+    ///@brief
+    ///     Gets the heuristic of board - It's never smaller than
+    ///     Heuristics::manhattanDistance() for the same board.
+    ///@warning board must have the database dimensions.
+    int getHeuristic(const FlatBoard &board) const;
+
+
+    // iVars //
+private:
+    void   *m_mapping;
+    size_t  m_mappingSize;
+
+    int m_width;
+    int m_height;
+    int m_patternsCount;
+    int m_tilesCount[kMaxPatternsCount];
+    int m_tiles     [kMaxPatternsCount][kMaxPatternTilesCount];
+
+    const uint8_t *m_tables[kMaxPatternsCount];
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_PatternDatabase_h__) //
@@ -0,0 +1,233 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PuzzleBank.h                              //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_PuzzleBank_h__
+#define __CorePuzzle15_include_PuzzleBank_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Writes puzzles into an indexed file that PuzzleBankReader
+///     looks up by (width, height, difficulty, index). The puzzles
+///     are streamed - Only one block per bucket is kept in memory.
+///@note
+///     File layout (host byte order, like the PatternDatabase):
+///       - FileHeader.
+///       - Blocks of puzzles - Each block has puzzles of a single
+///         bucket (width, height, difficulty), and all blocks but
+///         the last of a bucket are full, so the block of a puzzle
+///         is just index / blockPuzzlesCount.
+///       - Index: bucketsCount FileBuckets sorted by (width,
+///         height, difficulty), followed by the block offsets.
+///     Each puzzle is the seed (int32) followed by the cells, with
+///     the FlatBoard cell size of it's Board. The header has the
+///     Source of the seeds (and the series seed) of all puzzles.
+///@note
+///     The header is only written by close(), so a file that
+///     wasn't closed is never taken as valid.
+class PuzzleBank
+{
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief
+    ///     The version written in the header - Version 1 files
+    ///     have no source, they're all Source::GameCoreSeeds.
+    static const uint32_t kVersion = 2;
+
+    ///@brief The magic bytes that start every file.
+    static const char kMagic[8];
+
+    ///@brief The max size in bytes of a block.
+    static const uint32_t kBlockSize = 64 * 1024;
+
+    ///@brief What the seed of the puzzles is.
+    enum class Source : uint32_t {
+        GameCoreSeeds, ///< GameCore(width, height, maxMoves, seed) makes the Board.
+        Series         ///< GameCore(width, height, Series(seriesSeed, seed)) makes the Board.
+    };
+
+
+    // Inner Types //
+public:
+    struct Puzzle
+    {
+        //CTOR
+        Puzzle() :
+            seed      (0),
+            difficulty(0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        int       seed;       ///< Seed or index in the series, as the bank Source says.
+        int       difficulty; ///< Optimal moves count or heuristic distance.
+        FlatBoard board;
+    };
+
+    struct FileHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t bucketsCount;
+        uint64_t indexOffset;
+        uint64_t puzzlesCount;
+        uint32_t source;     ///< Source of all puzzles.
+        uint32_t padding;
+        uint64_t seriesSeed; ///< Seed of the series, for Source::Series.
+        uint8_t  reserved[16];
+    };
+
+    struct FileBucket
+    {
+        uint32_t width;
+        uint32_t height;
+        int32_t  difficulty;
+        uint32_t puzzleSize;
+        uint64_t puzzlesCount;
+        uint32_t blockPuzzlesCount;
+        uint32_t blocksCount;
+        uint64_t blocksOffset; ///< Offset of the uint64_t block offsets.
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs a bank with no file - open() must be called first.
+    PuzzleBank();
+
+    ///@brief Calls close().
+    ~PuzzleBank();
+
+    PuzzleBank(const PuzzleBank &) = delete;
+    PuzzleBank& operator =(const PuzzleBank &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief Creates (truncates) the file at path.
+    ///@returns True if the file could be created, false otherwise.
+    bool open(const std::string &path);
+
+    ///@brief
+    ///     Sets what the seeds of the puzzles are - It's written in
+    ///     the header. Default is Source::GameCoreSeeds.
+    ///@param seriesSeed The seed of the series, for Source::Series.
+    ///@returns
+    ///     True if it was set, false if puzzles of another source
+    ///     (or series) were already added.
+    bool setSource(Source source, uint64_t seriesSeed = 0);
+
+    ///@brief
+    ///     Appends puzzle to the end of it's bucket, i.e. it'll be
+    ///     the index getPuzzlesCount(width, height, difficulty) -1.
+    ///@returns True if it was written, false otherwise.
+    bool add(const Puzzle &puzzle);
+
+    ///@brief Writes the pending blocks, the index and the header.
+    ///@returns True if the file is complete, false otherwise.
+    bool close();
+
+    ///@brief Gets if there's a file open.
+    bool isOpen() const;
+
+    ///@brief Gets how many puzzles were added to the bucket.
+    uint64_t getPuzzlesCount(int width, int height, int difficulty) const;
+
+    ///@brief Gets how many puzzles were added since open().
+    uint64_t getPuzzlesCount() const;
+
+    ///@brief Gets what the seeds of the puzzles are.
+    Source getSource() const;
+
+    ///@brief Gets the seed of the series - Only for Source::Series.
+    uint64_t getSeriesSeed() const;
+
+
+    // Static Methods //
+public:
+    ///@brief Gets the bytes of a puzzle with a width x height Board.
+    static uint32_t getPuzzleSize(int width, int height);
+
+
+    // Private Types //
+private:
+    typedef std::tuple<int, int, int> BucketKey;
+
+    struct Bucket
+    {
+        uint32_t              puzzleSize;
+        uint32_t              blockPuzzlesCount;
+        uint64_t              puzzlesCount;
+        std::vector<uint8_t>  pending;
+        std::vector<uint64_t> blockOffsets;
+    };
+
+
+    // Private Methods //
+private:
+    bool writeBlock(Bucket &bucket);
+
+
+    // iVars //
+private:
+    std::ofstream                m_file;
+    std::map<BucketKey, Bucket>  m_buckets;
+    uint64_t                     m_offset;
+    uint64_t                     m_puzzlesCount;
+    Source                       m_source;
+    uint64_t                     m_seriesSeed;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_PuzzleBank_h__) //
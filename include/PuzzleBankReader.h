@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PuzzleBankReader.h                        //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_PuzzleBankReader_h__
+#define __CorePuzzle15_include_PuzzleBankReader_h__
+
+//std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "PuzzleBank.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Looks up the puzzles of a file written by PuzzleBank.
+///     The file is mapped (mmap) and only the index is read by
+///     load() - Each get() touches just the puzzle it reads, so
+///     files much bigger than the memory can be served.
+///@note
+///     All methods are const after load(), so many threads can
+///     share a single reader.
+class PuzzleBankReader
+{
+    // Inner Types //
+public:
+    struct BucketInfo
+    {
+        int      width;
+        int      height;
+        int      difficulty;
+        uint64_t puzzlesCount;
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs a reader with no file.
+    PuzzleBankReader();
+    ~PuzzleBankReader();
+
+    PuzzleBankReader(const PuzzleBankReader &) = delete;
+    PuzzleBankReader& operator =(const PuzzleBankReader &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief Maps the file at path and checks it's index.
+    ///@returns True if it's a complete and valid file, false otherwise.
+    bool load(const std::string &path);
+
+    ///@brief Unmaps the file - Safe to call always.
+    void close();
+
+    ///@brief Gets if there's a file loaded.
+    bool isOpen() const;
+
+
+    ///@brief Gets how many puzzles the file has.
+    uint64_t getPuzzlesCount() const;
+
+    ///@brief Gets how many puzzles the bucket has (0 if there's none).
+    uint64_t getPuzzlesCount(int width, int height, int difficulty) const;
+
+    ///@brief Gets what the seeds of the puzzles are.
+    PuzzleBank::Source getSource() const;
+
+    ///@brief Gets the seed of the series - Only for Source::Series.
+    uint64_t getSeriesSeed() const;
+
+    ///@brief Gets all buckets sorted by (width, height, difficulty).
+    std::vector<BucketInfo> getBuckets() const;
+
+    ///@brief
+    ///     Reads the puzzle index of the bucket into puzzle.
+    ///     It's O(log buckets) and reads only the puzzle bytes.
+    ///@returns True if the puzzle exists, false otherwise.
+    bool get(int width, int height, int difficulty, uint64_t index,
+             PuzzleBank::Puzzle &puzzle) const;
+
+
+    // Private Methods //
+private:
+    bool readIndex();
+    const PuzzleBank::FileBucket* findBucket(int width, int height,
+                                             int difficulty) const;
+
+
+    // iVars //
+private:
+    void   *m_mapping;
+    size_t  m_size;
+
+    const uint8_t                *m_data;
+    const PuzzleBank::FileHeader *m_header;
+    const PuzzleBank::FileBucket *m_buckets;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_PuzzleBankReader_h__) //
@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PuzzleGenerator.h                         //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_PuzzleGenerator_h__
+#define __CorePuzzle15_include_PuzzleGenerator_h__
+
+//std
+#include <cstdint>
+#include <functional>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "PatternDatabase.h"
+#include "PuzzleBank.h"
+#include "Solver.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Makes puzzles in bulk - The Boards of a range of seeds are
+///     generated and rated on a pool of threads, and given back in
+///     seed order, so the same options always give the same output.
+///@note
+///     The work goes in rounds of kRoundPuzzlesCount puzzles, the
+///     threads take chunks of a round with a single atomic add.
+///     Only one round is in memory, so any count can be streamed
+///     into a PuzzleBank.
+///@note
+///     With Source::Series each Board depends only on the series
+///     seed and it's index, so a part of a series can be made on
+///     other machines and be the same.
+class PuzzleGenerator
+{
+    // Constants / Enums / Typedefs //
+public:
+    enum class Rating {
+        Exact,     ///< Optimal moves count (Solver) - Up to Solver::kMaxCellsCount.
+        Heuristic  ///< Manhattan distance + linear conflict - Any size.
+    };
+
+    ///@brief
+    ///     Where the Boards come from - With Source::Series the
+    ///     Board of index is makeSeriesBoard(seriesSeed, index).
+    typedef PuzzleBank::Source Source;
+
+    ///@brief Puzzles generated in parallel before they're given back.
+    static const int kRoundPuzzlesCount = 4096;
+
+    ///@brief Puzzles that a thread takes at once.
+    static const int kChunkPuzzlesCount = 16;
+
+
+    // Inner Types //
+public:
+    struct Options
+    {
+        //CTOR
+        Options() :
+            width           (4),
+            height          (4),
+            firstSeed       (0),
+            count           (0),
+            source          (Source::GameCoreSeeds),
+            seriesSeed      (0),
+            rating          (Rating::Exact),
+            maxExpandedNodes(Solver::kUnlimitedNodes),
+            database        (nullptr),
+            threadsCount    (0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        int      width;
+        int      height;
+        int      firstSeed;        ///< Seeds (or indexes) go from firstSeed to firstSeed + count -1.
+        uint64_t count;
+        Source   source;
+        uint64_t seriesSeed;       ///< Seed of the series, for Source::Series.
+        Rating   rating;
+        uint64_t maxExpandedNodes; ///< Exact Boards past it are skipped.
+        const PatternDatabase *database; ///< Optional, for Exact.
+        int      threadsCount;     ///< 0 uses one per hardware thread.
+    };
+
+    struct Stats
+    {
+        //CTOR
+        Stats() :
+            generatedCount(0),
+            skippedCount  (0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        uint64_t generatedCount; ///< Puzzles given back.
+        uint64_t skippedCount;   ///< Puzzles that couldn't be rated.
+    };
+
+    ///@brief
+    ///     Receives each puzzle, in seed order, from the calling
+    ///     thread of generate(). Returns false to stop.
+    typedef std::function<bool (const PuzzleBank::Puzzle &)> Callback;
+
+
+    // Public Methods //
+public:
+    PuzzleGenerator() = delete;
+
+    ///@brief
+    ///     Generates and rates the puzzles of options.
+    ///@returns
+    ///     The counts - Nothing is done if options are invalid
+    ///     (firstSeed < 0, or seeds past INT_MAX).
+    static Stats generate(const Options &options, const Callback &callback);
+
+    ///@brief
+    ///     Generates and rates the puzzles into bank (must be open).
+    ///     The source of options is set in bank - Nothing is done if
+    ///     it already has puzzles of another one.
+    static Stats generate(const Options &options, PuzzleBank &bank);
+
+
+    ///@brief
+    ///     Fills board with the Board that
+    ///     GameCore(width, height, maxMoves, seed) starts with.
+    ///@param board The board to fill - It's dimensions are kept.
+    static void makeBoard(int seed, FlatBoard &board);
+
+    ///@brief
+    ///     Fills board with the Board at index of the series of
+    ///     seriesSeed - It's shuffled by the CounterRandom stream
+    ///     (seriesSeed, index), so each Board is made alone in
+    ///     O(width * height), on any thread, with the same cells.
+    ///     It's the Board of:
+    ///       GameCore(width, height, BoardGenerator::Series(seriesSeed, index));
+    ///@param board The board to fill - It's dimensions are kept.
+    ///@see CounterRandom.
+    static void makeSeriesBoard(uint64_t seriesSeed,
+                                uint64_t index,
+                                FlatBoard &board);
+
+    ///@brief
+    ///     Gets the difficulty of board.
+    ///@param solver Used by Rating::Exact.
+    ///@returns
+    ///     The difficulty or -1 if it couldn't be found
+    ///     (Board too big or solver node limit).
+    static int rate(const FlatBoard &board, Rating rating, Solver &solver);
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_PuzzleGenerator_h__) //
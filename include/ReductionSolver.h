@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        ReductionSolver.h                         //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_ReductionSolver_h__
+#define __CorePuzzle15_include_ReductionSolver_h__
+
+//std
+#include <chrono>
+#include <cstdint>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+#include "Solver.h"
+//CoreCoord
+#include "CoreCoord.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Finds (far from optimal) solutions of Boards of any size,
+///     the way people do - The top row (or the left column, the
+///     longer one) is put in place and never touched again, so the
+///     Board left is one line smaller. When it's down to 3x3 the
+///     Solver finishes it optimally.
+///@note
+///     Each tile is pushed toward it's goal a cell at a time, with
+///     the empty tile going around it. The last two tiles of a line
+///     are brought near their goals and then placed together by a
+///     search over a small window of cells.
+///@note
+///     The time is about O(cells * (width + height)), with as many
+///     moves - Big Boards give very long solutions.
+class ReductionSolver
+{
+    // Constants / Enums / Typedefs //
+public:
+    typedef std::chrono::steady_clock Clock;
+
+
+    // Inner Types //
+public:
+    struct Result
+    {
+        //Types
+        enum class Status {
+            Solved,      ///< moves has a solution.
+            Unsolvable,  ///< Board can't be solved at all.
+            Timeout,     ///< Gave up at the deadline.
+            Unsupported  ///< Board is a single line (of more than Solver::kMaxCellsCount).
+        };
+
+        //CTOR
+        Result() :
+            status(Status::Unsupported)
+        {
+            //Empty...
+        }
+
+        //Vars
+        Status status;
+
+        ///@brief
+        ///     The coords of the tiles to move, in order.
+        ///     Each one can be passed straight to GameCore::move().
+        CoreCoord::Coord::Vec moves;
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ReductionSolver();
+
+
+    // Public Methods //
+public:
+    ///@brief Finds a solution for the current Board of core.
+    Result solve(const GameCore &core);
+
+    ///@brief Finds a solution for board.
+    Result solve(const FlatBoard &board);
+
+
+    ///@brief
+    ///     Sets when the search gives up - It's checked for each tile.
+    ///@param deadline The time or Clock::time_point::max() for none.
+    void setDeadline(const Clock::time_point &deadline);
+
+    ///@brief Gets when the search gives up.
+    const Clock::time_point& getDeadline() const;
+
+
+    // Private Methods //
+private:
+    bool solveLine   (bool isCol);
+    bool solveLineEnd(int line, int end, int start, bool isCol);
+    bool solveRest   ();
+
+    bool moveTile (int value, int target);
+    bool moveEmpty(int target);
+    bool moveEmptyStraight(int target, bool rowFirst);
+    bool moveEmptySearch  (int target, int margin);
+    bool placePair(int valueA, int targetA, int valueB, int targetB,
+                   int lines, int line, int end, int start, bool isCol);
+
+    void slide(int index);
+
+    int  getCell(int line, int position, bool isCol) const;
+    bool isFree (int index) const;
+    bool isTimeout();
+
+    // iVars //
+private:
+    Clock::time_point m_deadline;
+    Solver            m_solver;
+
+    int m_width;
+    int m_height;
+    int m_top;  //The Board left is from (m_top, m_left)
+    int m_left; //to the bottom right corner.
+
+    std::vector<int>     m_cells;     //[index] = value
+    std::vector<int>     m_positions; //[value] = index
+    std::vector<uint8_t> m_fixed;     //[index] = Can't be moved.
+    int                  m_emptyIndex;
+
+    std::vector<int32_t> m_path; //Index of each moved tile.
+
+    //Search scratch - Visits are stamped so nothing is cleared.
+    std::vector<int32_t>  m_parents;
+    std::vector<uint32_t> m_visits;
+    uint32_t              m_visitStamp;
+    std::vector<int32_t>  m_queue;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_ReductionSolver_h__) //
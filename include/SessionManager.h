@@ -0,0 +1,244 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        SessionManager.h                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_SessionManager_h__
+#define __CorePuzzle15_include_SessionManager_h__
+
+//std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+//CorePuzzle15
+#include "CacheLineArray.h"
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+//CoreCoord
+#include "CoreCoord.h"
+//CoreGame
+#include "CoreGame.h"
+//CoreRandom
+#include "CoreRandom.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Keeps the GameCores of many players (sessions) that are
+///     moved and read by many threads at once.
+///@note
+///     Sessions are split in shards, each one with a slab of slots
+///     made by the CTOR. A SessionId is the shard, the slot and the
+///     generation of the slot - So finding a session is just reading
+///     the id, there's no map and no lock. A destroyed id never
+///     matches again, even after it's slot is reused.
+///@note
+///     Each slot has it's own mutex that only move() / undo() of
+///     that session take - Moves of different players never contend.
+///     The shard mutex is only taken by create() and destroy().
+///@note
+///     After each move the slot publishes the cells that changed, the
+///     status and the moves count. getStatus() and getMovesCount()
+///     are wait-free (a couple of atomic loads).
+///@warning
+///     getBoard() is a seqlock read and is NOT wait-free - It never
+///     blocks the writer, but it spins while a move of that session
+///     is being published and copies again if one lands in the
+///     middle. A session moved nonstop can keep it retrying, and a
+///     writer preempted mid publish stalls it. Its cost is bounded
+///     only by how often that one session moves.
+class SessionManager
+{
+    // Constants / Enums / Typedefs //
+public:
+    typedef uint64_t SessionId;
+
+    ///@brief Never given by create().
+    static const SessionId kInvalidSessionId = 0;
+
+    ///@brief Max shards - They're 8 bits of the SessionId.
+    static const int kMaxShardsCount = 256;
+
+    ///@brief Max slots of each shard - They're 24 bits of the SessionId.
+    static const int kMaxSessionsPerShard = 1 << 24;
+
+
+    // Inner Types //
+public:
+    struct Options
+    {
+        //CTOR
+        Options() :
+            shardsCount     (16),
+            sessionsPerShard(256),
+            maxCellsCount   (256)
+        {
+            //Empty...
+        }
+
+        //Vars
+        int shardsCount;      ///< Up to kMaxShardsCount.
+        int sessionsPerShard; ///< Up to kMaxSessionsPerShard.
+        int maxCellsCount;    ///< Biggest Board (width * height) of a session.
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief
+    ///     Makes all the slots and their cells - create() only
+    ///     allocates the first time a slot gets a GameCore.
+    explicit SessionManager(const Options &options = Options());
+    ~SessionManager();
+
+    SessionManager(const SessionManager &) = delete;
+    SessionManager& operator =(const SessionManager &) = delete;
+
+
+    // Public Methods //
+public:
+    ///@brief
+    ///     Starts a new session with a new game, as GameCore was
+    ///     constructed with the same args.
+    ///@returns
+    ///     The id of the session or kInvalidSessionId if the Board
+    ///     is bigger than Options::maxCellsCount or all slots are in use.
+    ///@see GameCore CTOR.
+    SessionId create(int width,
+                     int height,
+                     int maxMoves = GameCore::kUnlimitedMoves,
+                     int seed     = CoreRandom::Random::kRandomSeed);
+
+    ///@brief
+    ///     Ends the session - It's slot goes back to the shard.
+    ///@returns False if there's no such session.
+    bool destroy(SessionId id);
+
+
+    ///@brief
+    ///     Same as GameCore::moveFast() on the session.
+    ///@returns False if there's no such session - summary is untouched.
+    bool move(SessionId id,
+              const CoreCoord::Coord &coord,
+              GameCore::MoveSummary &summary);
+
+    ///@brief
+    ///     Same as GameCore::undo() on the session.
+    ///@returns False if there's no such session - summary is untouched.
+    bool undo(SessionId id, GameCore::MoveSummary &summary);
+
+
+    ///@brief Gets the game Status of the session - Wait-free.
+    ///@returns False if there's no such session - status is untouched.
+    bool getStatus(SessionId id, CoreGame::Status &status) const;
+
+    ///@brief Gets how many moves the session did - Wait-free.
+    ///@returns False if there's no such session - movesCount is untouched.
+    bool getMovesCount(SessionId id, int &movesCount) const;
+
+    ///@brief
+    ///     Copies the Board of the session into board, as it was
+    ///     between two moves. board memory is reused when possible.
+    ///@returns False if there's no such session.
+    ///@warning Not wait-free - Retries while that session moves.
+    bool getBoard(SessionId id, FlatBoard &board) const;
+
+
+    ///@brief Gets if id is a session that is alive.
+    bool isValid(SessionId id) const;
+
+    ///@brief Gets how many sessions are alive.
+    size_t getSessionsCount() const;
+
+    ///@brief Gets the options given to the CTOR.
+    const Options& getOptions() const;
+
+
+    // Private Types //
+private:
+    //A cache line (or two) each, so writers of near
+    //sessions don't invalidate each other's lines.
+    struct alignas(COREPUZZLE15_CACHE_LINE_SIZE) Slot
+    {
+        std::mutex                 mutex;      //Writers of the session.
+        std::atomic<uint32_t>      generation; //Odd while alive.
+        std::atomic<uint32_t>      sequence;   //Odd while publishing.
+        std::atomic<int32_t>       width;
+        std::atomic<int32_t>       height;
+        std::atomic<int32_t>       status;
+        std::atomic<int32_t>       movesCount;
+        std::atomic<uint32_t>     *cells;      //Into the shard cells.
+        std::unique_ptr<GameCore>  core;       //Kept (and reset) on reuse.
+    };
+
+    struct Shard
+    {
+        std::mutex                            mutex; //create() / destroy().
+        CacheLineArray<Slot>                  slots;
+        CacheLineArray<std::atomic<uint32_t>> cells; //Cells stride per slot.
+        std::vector<uint32_t>                 freeSlots;
+    };
+
+
+    // Private Methods //
+private:
+    Slot*       findSlot(SessionId id);
+    const Slot* findSlot(SessionId id) const;
+
+    bool isAlive(const Slot &slot, SessionId id) const;
+
+    void publish     (Slot &slot, int fromIndex, int toIndex);
+    void publishBoard(Slot &slot);
+    void publishState(Slot &slot);
+
+
+    // iVars //
+private:
+    Options                  m_options;
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic<uint32_t>    m_nextShard;
+    std::atomic<size_t>      m_sessionsCount;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_SessionManager_h__) //
@@ -0,0 +1,243 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Solver.h                                  //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_Solver_h__
+#define __CorePuzzle15_include_Solver_h__
+
+//std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+#include "GameCore.h"
+#include "PatternDatabase.h"
+//CoreCoord
+#include "CoreCoord.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Finds optimal (shortest) solutions with IDA* using the
+///     Manhattan distance plus the linear conflict heuristic.
+///     If a PatternDatabase for the Board size is set, the
+///     heuristic is the biggest of it and the linear conflict one.
+///@note
+///     The search works over a packed copy of the Board - One
+///     byte per cell - that is changed in place, so no memory
+///     is allocated while expanding nodes. The heuristic is
+///     updated incrementally, only the lines touched by
+///     each move are evaluated again.
+///@note
+///     A Solver keeps it's own search state, so each thread
+///     must use it's own Solver.
+class Solver
+{
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief The biggest Board (width * height) that can be solved.
+    static const int kMaxCellsCount = 64;
+
+    ///@brief Meta-value to indicate that search has no node limit.
+    static const uint64_t kUnlimitedNodes;
+
+    typedef std::chrono::steady_clock Clock;
+
+
+    // Inner Types //
+public:
+    struct Result
+    {
+        //Types
+        enum class Status {
+            Solved,      ///< moves has an optimal solution.
+            Unsolvable,  ///< Board can't be solved at all.
+            NodeLimit,   ///< Gave up after the max expanded nodes.
+            Timeout,     ///< Gave up at the deadline.
+            Unsupported  ///< Board is too big (or has no room to move).
+        };
+
+        //CTOR
+        Result() :
+            status       (Status::Unsupported),
+            expandedNodes(0)
+        {
+            //Empty...
+        }
+
+        //Vars
+        Status                status;
+        uint64_t              expandedNodes;
+
+        ///@brief
+        ///     The coords of the tiles to move, in order.
+        ///     Each one can be passed straight to GameCore::move().
+        CoreCoord::Coord::Vec moves;
+    };
+
+
+    // CTOR/DTOR //
+public:
+    ///@brief Constructs a Solver with kUnlimitedNodes.
+    Solver();
+
+
+    // Public Methods //
+public:
+    ///@brief Finds an optimal solution for the current Board of core.
+    Result solve(const GameCore &core);
+
+    ///@brief Finds an optimal solution for board.
+    Result solve(const FlatBoard &board);
+
+
+    ///@brief
+    ///     Sets how many nodes can be expanded before giving up.
+    ///@param maxNodes The max nodes or kUnlimitedNodes.
+    void setMaxExpandedNodes(uint64_t maxNodes);
+
+    ///@brief Gets how many nodes can be expanded before giving up.
+    uint64_t getMaxExpandedNodes() const;
+
+
+    ///@brief
+    ///     Sets when the search gives up - It's checked every few
+    ///     thousand nodes, so it's passed by microseconds at most.
+    ///@param deadline The time or Clock::time_point::max() for none.
+    void setDeadline(const Clock::time_point &deadline);
+
+    ///@brief Gets when the search gives up.
+    const Clock::time_point& getDeadline() const;
+
+
+    ///@brief
+    ///     Sets the pattern database used for boards of it's size.
+    ///     Other sizes keep using the linear conflict alone.
+    ///@param database
+    ///     The loaded database or nullptr to not use one.
+    ///     It must outlive the solve() calls.
+    void setPatternDatabase(const PatternDatabase *database);
+
+
+    // Inner Types //
+private:
+    //What doMove() changed, so undoMove() can take it back.
+    struct MoveUndo
+    {
+        int  index;
+        int  emptyIndex;
+        int  manhattanDelta;
+        int  lineIndex;
+        bool lineIsCol;
+        int  oldConflict;
+        int  pattern;
+        int  oldEntry;
+    };
+
+
+    // Private Methods //
+private:
+    void initTables(const FlatBoard &board);
+
+    int  rowConflict(int row) const;
+    int  colConflict(int col) const;
+    int  patternEntry(int pattern) const;
+
+    int  getHeuristic() const;
+    void doMove  (int index, MoveUndo &undo);
+    void undoMove(const MoveUndo &undo);
+
+    bool shouldStop();
+    bool search(int cost, int prevIndex);
+
+    //Drives the search (on many Solvers) from the outside.
+    friend class ParallelSolver;
+
+
+    // iVars //
+private:
+    uint64_t m_maxExpandedNodes;
+    uint64_t m_expandedNodes;
+
+    Clock::time_point        m_deadline;
+    const std::atomic<bool> *m_stop; //Set by other threads to give up.
+    Result::Status           m_abortStatus;
+
+    int m_width;
+    int m_height;
+    int m_cellsCount;
+
+    //Packed state.
+    uint8_t m_cells[kMaxCellsCount];
+    int     m_emptyIndex;
+
+    //Precomputed tables.
+    uint8_t m_distances     [kMaxCellsCount][kMaxCellsCount]; //[value][index]
+    int8_t  m_neighbors     [kMaxCellsCount][4];
+    int8_t  m_neighborsCount[kMaxCellsCount];
+    int8_t  m_rows          [kMaxCellsCount];
+    int8_t  m_cols          [kMaxCellsCount];
+
+    //Heuristic - Updated incrementally.
+    int m_manhattan;
+    int m_conflict;
+    int m_rowConflicts[kMaxCellsCount];
+    int m_colConflicts[kMaxCellsCount];
+
+    //Pattern database - Updated incrementally.
+    const PatternDatabase *m_database;
+    bool                   m_usingDatabase;
+    int                    m_patternsExtra;
+    int8_t                 m_patternOf     [kMaxCellsCount]; //[value]
+    uint8_t                m_positions     [kMaxCellsCount]; //[value]
+    int                    m_patternEntries[PatternDatabase::kMaxPatternsCount];
+
+    //Search.
+    int              m_bound;
+    int              m_nextBound;
+    bool             m_aborted;
+    std::vector<int> m_path;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_Solver_h__) //
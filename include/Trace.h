@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Trace.h                                   //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_Trace_h__
+#define __CorePuzzle15_include_Trace_h__
+
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "GameCore.h"
+//CoreGame
+#include "CoreGame.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Receives the trace events of all GameCores - Override only
+///     the events of interest, the others do nothing.
+///@note
+///     The events are called in the thread that does the work,
+///     while it's doing it, so the sink must be thread safe and
+///     fast. It must not change the GameCore it receives.
+///@see Trace.
+class TraceSink
+{
+    // CTOR/DTOR //
+public:
+    virtual ~TraceSink() {}
+
+
+    // Events //
+public:
+    ///@brief A Board was made (CTOR or GameCore::reset()).
+    virtual void onBoardGenerated(const GameCore &core)
+    {
+        (void)core;
+    }
+
+    ///@brief A move shifted summary.tilesCount tiles.
+    virtual void onMove(const GameCore &core,
+                        const GameCore::MoveSummary &summary)
+    {
+        (void)core; (void)summary;
+    }
+
+    ///@brief The last move was taken back.
+    virtual void onUndo(const GameCore &core,
+                        const GameCore::MoveSummary &summary)
+    {
+        (void)core; (void)summary;
+    }
+
+    ///@brief The last undone move was done again.
+    virtual void onRedo(const GameCore &core,
+                        const GameCore::MoveSummary &summary)
+    {
+        (void)core; (void)summary;
+    }
+
+    ///@brief The status went from oldStatus to the current one.
+    virtual void onStatusChanged(const GameCore &core,
+                                 CoreGame::Status oldStatus)
+    {
+        (void)core; (void)oldStatus;
+    }
+};
+
+
+///@brief
+///     Holds the TraceSink that GameCore reports to.
+///     Tracing is only compiled in when the library is built with
+///     __AMAZINGCORE_COREPUZZLE15_TRACE_ENABLED__ - Otherwise the
+///     COREPUZZLE15_TRACE points expand to nothing and the sink is
+///     never called.
+class Trace
+{
+    // Public Methods //
+public:
+    Trace() = delete;
+
+    ///@brief Gets if the trace points were compiled in.
+    static constexpr bool isEnabled()
+    {
+    #ifdef __AMAZINGCORE_COREPUZZLE15_TRACE_ENABLED__
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    ///@brief
+    ///     Sets the sink of all GameCores.
+    ///@param sink
+    ///     The sink or nullptr to stop tracing.
+    ///     It must outlive the tracing.
+    static void setSink(TraceSink *sink);
+
+    ///@brief Gets the current sink or nullptr.
+    static TraceSink* getSink();
+};
+
+NS_COREPUZZLE15_END
+
+
+//Calls the event on the sink if there's one - e.g.
+//  COREPUZZLE15_TRACE(onMove(*this, summary));
+#ifdef __AMAZINGCORE_COREPUZZLE15_TRACE_ENABLED__
+    #define COREPUZZLE15_TRACE(_event_)                                  \
+        do {                                                             \
+            if(auto _sink_ = CorePuzzle15::Trace::getSink())             \
+                _sink_->_event_;                                         \
+        } while(0)
+#else
+    #define COREPUZZLE15_TRACE(_event_) do {} while(0)
+#endif
+
+#endif // defined(__CorePuzzle15_include_Trace_h__) //
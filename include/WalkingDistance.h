@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        WalkingDistance.h                         //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_WalkingDistance_h__
+#define __CorePuzzle15_include_WalkingDistance_h__
+
+//std
+#include <cstdint>
+#include <vector>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Walking distance tables - The Board is seen only as how many
+///     tiles of each goal line are in each line (and the line of the
+///     empty tile). The table has the least number of moves that
+///     takes each of those states to the solved one, when any tile
+///     of a line next to the empty tile can go to the empty line.
+///     The rows distance plus the columns distance is admissible.
+///@note
+///     A table depends only on the number of lines and their length,
+///     it's built once (BFS from the solved state) on the first get()
+///     and shared by all threads - get() is thread safe.
+///@note
+///     The number of states grows very fast with the number of lines,
+///     sizes with more than kMaxStatesCount states have no table.
+///     All 3xN and 4x4 Boards are fine, 5x5 isn't.
+class WalkingDistance
+{
+    // Constants / Enums / Typedefs //
+public:
+    ///@brief The max number of states of a table.
+    static const int kMaxStatesCount = 1 << 19;
+
+    ///@brief Which lines of a Board a table is for.
+    enum class Lines {
+        Rows,   ///< linesCount = height, lineLength = width.
+        Columns ///< linesCount = width,  lineLength = height.
+    };
+
+
+    // CTOR/DTOR //
+public:
+    WalkingDistance(const WalkingDistance &) = delete;
+    WalkingDistance& operator =(const WalkingDistance &) = delete;
+
+private:
+    WalkingDistance(int linesCount, int lineLength);
+
+
+    // Static Methods //
+public:
+    ///@brief
+    ///     Gets the shared table of linesCount lines of lineLength
+    ///     tiles - It's built on the first call.
+    ///@returns The table or nullptr if the size has too many states.
+    static const WalkingDistance* get(int linesCount, int lineLength);
+
+    ///@brief Gets the table of the lines of board.
+    ///@returns The table or nullptr if the size has too many states.
+    static const WalkingDistance* get(const FlatBoard &board, Lines lines);
+
+
+    // Public Methods //
+public:
+    ///@brief Gets the number of lines.
+    int getLinesCount() const;
+
+    ///@brief Gets the length of each line.
+    int getLineLength() const;
+
+
+    ///@brief Gets the key of the lines of board (the table must fit it).
+    uint64_t getKey(const FlatBoard &board, Lines lines) const;
+
+    ///@brief
+    ///     Gets how much the key changes for each tile of goalLine
+    ///     that is in line - Moving a tile of goalLine from line a to
+    ///     line b adds getWeight(b, goalLine) - getWeight(a, goalLine).
+    inline uint64_t getWeight(int line, int goalLine) const
+    {
+        return m_weights[line * m_linesCount + goalLine];
+    }
+
+    ///@brief
+    ///     Gets how much the key changes for each line that the empty
+    ///     tile goes down (or right).
+    inline uint64_t getEmptyWeight() const
+    {
+        return m_emptyWeight;
+    }
+
+    ///@brief Gets the moves count of the state of key.
+    ///@returns The moves count or -1 if key isn't a state of the table.
+    int getDistance(uint64_t key) const;
+
+
+    // Private Methods //
+private:
+    bool build();
+    void insert(uint64_t key, int distance);
+
+    // iVars //
+private:
+    int m_linesCount;
+    int m_lineLength;
+
+    //Key = Sum of count[line][goal] * weight[line][goal] +
+    //      emptyLine * emptyWeight. The last goal line of each line
+    //      is left out (weight 0), the line length gives it.
+    std::vector<uint64_t> m_weights;
+    uint64_t              m_emptyWeight;
+
+    //Open addressing - Empty slots have kEmptyKey.
+    std::vector<uint64_t> m_keys;
+    std::vector<uint8_t>  m_distances;
+    int                   m_shift;
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_WalkingDistance_h__) //
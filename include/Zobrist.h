@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Zobrist.h                                 //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+#ifndef __CorePuzzle15_include_Zobrist_h__
+#define __CorePuzzle15_include_Zobrist_h__
+
+//std
+#include <cstdint>
+//CorePuzzle15
+#include "CorePuzzle15_Utils.h"
+#include "FlatBoard.h"
+
+
+NS_COREPUZZLE15_BEGIN
+
+///@brief
+///     Zobrist hashing of Boards - The hash is the XOR of one key
+///     for each (value, index) pair, so swapping two cells updates
+///     it in O(1) with 4 XORs.
+///@note
+///     The keys are computed (SplitMix64 of the pair) instead of
+///     looked up, so there's no (width * height)^2 table to keep
+///     for the big boards and they are the same in all processes.
+class Zobrist
+{
+    // Public Methods //
+public:
+    ///@brief Gets the key of value placed at index.
+    inline static uint64_t getKey(int value, int index)
+    {
+        auto z = (static_cast<uint64_t>(value) << 32)
+               |  static_cast<uint32_t>(index);
+
+        z += 0x9E3779B97F4A7C15ull;
+        z  = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z  = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    ///@brief
+    ///     Gets the hash change of swapping the values
+    ///     value1 (at index1) and value2 (at index2).
+    inline static uint64_t getSwapDelta(int value1, int index1,
+                                        int value2, int index2)
+    {
+        return getKey(value1, index1) ^ getKey(value2, index2)
+             ^ getKey(value1, index2) ^ getKey(value2, index1);
+    }
+
+    ///@brief Gets the hash of the whole board.
+    static uint64_t hash(const FlatBoard &board);
+};
+
+NS_COREPUZZLE15_END
+#endif // defined(__CorePuzzle15_include_Zobrist_h__) //
@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        main.cpp                                  //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//std
+#include <cstdlib>
+#include <iostream>
+//CorePuzzle15
+#include "../include/CorePuzzle15.h"
+
+USING_NS_COREPUZZLE15;
+using namespace std;
+
+
+void usage()
+{
+    cout << "Amazing Cow - CorePuzzle15 Pattern Database Builder" << endl;
+    cout << "Usage: " << endl;
+    cout << "   pdbbuilder <width> <height> <output file>" << endl;
+    cout << "Example: " << endl;
+    cout << "   pdbbuilder      4        4   puzzle15.pdb" << endl;
+    cout << "   pdbbuilder      5        5   puzzle24.pdb" << endl;
+    cout << "Notes: " << endl;
+    cout << "   Only 4x4 (6-6-3) and 5x5 (6-6-6-6) have default patterns." << endl;
+
+    exit(1);
+}
+
+int main(int argc, const char *argv[])
+{
+    if(argc != 4)
+        usage();
+
+    int w = atoi(argv[1]);
+    int h = atoi(argv[2]);
+
+    auto patterns = PatternDatabase::getDefaultPatterns(w, h);
+    if(patterns.empty())
+        usage();
+
+    cout << "Building " << w << "x" << h << " pattern database..." << endl;
+    if(!PatternDatabase::build(w, h, patterns, argv[3]))
+    {
+        cerr << "Failed to build: " << argv[3] << endl;
+        return 1;
+    }
+
+    cout << "Done: " << argv[3] << endl;
+    return 0;
+}
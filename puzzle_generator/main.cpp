@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        main.cpp                                  //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//std
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+//CorePuzzle15
+#include "../include/CorePuzzle15.h"
+
+USING_NS_COREPUZZLE15;
+using namespace std;
+
+
+void usage()
+{
+    cout << "Amazing Cow - CorePuzzle15 Puzzle Generator" << endl;
+    cout << "Usage: " << endl;
+    cout << "   puzzlegen <width> <height> <count> <exact|heuristic> <output file> [first seed] [pdb file]" << endl;
+    cout << "   puzzlegen lookup <bank file> <width> <height> <difficulty> <index>" << endl;
+    cout << "Example: " << endl;
+    cout << "   puzzlegen 4 4 1000000 exact puzzles.bank 0 puzzle15.pdb" << endl;
+    cout << "   puzzlegen 8 8 1000000 heuristic puzzles.bank" << endl;
+    cout << "   puzzlegen lookup puzzles.bank 4 4 50 123" << endl;
+    cout << "Notes: " << endl;
+    cout << "   Exact difficulty is the optimal moves count, only for boards" << endl;
+    cout << "   up to " << Solver::kMaxCellsCount << " cells. Heuristic is Manhattan distance + linear conflict." << endl;
+
+    exit(1);
+}
+
+int lookup(int argc, const char *argv[])
+{
+    if(argc != 7)
+        usage();
+
+    PuzzleBankReader reader;
+    if(!reader.load(argv[2]))
+    {
+        cerr << "Failed to load: " << argv[2] << endl;
+        return 1;
+    }
+
+    PuzzleBank::Puzzle puzzle;
+    if(!reader.get(atoi(argv[3]), atoi(argv[4]), atoi(argv[5]),
+                   strtoull(argv[6], nullptr, 10), puzzle))
+    {
+        cerr << "No such puzzle." << endl;
+        return 1;
+    }
+
+    cout << "Seed: " << puzzle.seed << endl;
+    for(int i = 0; i < puzzle.board.getCellsCount(); ++i)
+    {
+        cout << puzzle.board.getValueAt(i)
+             << (((i + 1) % puzzle.board.getWidth() == 0) ? "\n" : " ");
+    }
+
+    return 0;
+}
+
+int main(int argc, const char *argv[])
+{
+    if(argc >= 2 && string(argv[1]) == "lookup")
+        return lookup(argc, argv);
+
+    if(argc < 6 || argc > 8)
+        usage();
+
+    PuzzleGenerator::Options options;
+    options.width  = atoi(argv[1]);
+    options.height = atoi(argv[2]);
+    options.count  = strtoull(argv[3], nullptr, 10);
+
+    string rating = argv[4];
+    if(rating == "exact")
+        options.rating = PuzzleGenerator::Rating::Exact;
+    else if(rating == "heuristic")
+        options.rating = PuzzleGenerator::Rating::Heuristic;
+    else
+        usage();
+
+    if(options.rating == PuzzleGenerator::Rating::Exact &&
+       options.width * options.height > Solver::kMaxCellsCount)
+    {
+        usage();
+    }
+
+    if(argc >= 7)
+        options.firstSeed = atoi(argv[6]);
+
+    PatternDatabase database;
+    if(argc == 8)
+    {
+        if(!database.load(argv[7]))
+        {
+            cerr << "Failed to load: " << argv[7] << endl;
+            return 1;
+        }
+        options.database = &database;
+    }
+
+    PuzzleBank bank;
+    if(!bank.open(argv[5]))
+    {
+        cerr << "Failed to create: " << argv[5] << endl;
+        return 1;
+    }
+
+    cout << "Generating " << options.count << " "
+         << options.width << "x" << options.height << " puzzles..." << endl;
+
+    auto stats = PuzzleGenerator::generate(options, bank);
+    if(!bank.close())
+    {
+        cerr << "Failed to write: " << argv[5] << endl;
+        return 1;
+    }
+
+    PuzzleBankReader reader;
+    reader.load(argv[5]);
+    for(const auto &bucket : reader.getBuckets())
+    {
+        cout << "   " << bucket.width << "x" << bucket.height
+             << " difficulty " << bucket.difficulty
+             << ": " << bucket.puzzlesCount << endl;
+    }
+
+    cout << "Done: " << argv[5] << " - "
+         << stats.generatedCount << " puzzles, "
+         << stats.skippedCount   << " skipped" << endl;
+
+    return 0;
+}
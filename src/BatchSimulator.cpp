@@ -0,0 +1,208 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BatchSimulator.cpp                        //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/BatchSimulator.h"
+//std
+#include <algorithm>
+#include <chrono>
+//CorePuzzle15
+#include "../include/GameCorePool.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+namespace {
+
+//How many jobs are taken from a range at once.
+const size_t kChunkSize = 8;
+
+} //anonymous namespace
+
+
+// CTOR/DTOR //
+BatchSimulator::BatchSimulator(int threadsCount) :
+    m_threadsCount  (threadsCount),
+    m_generation    (0),
+    m_pendingWorkers(0),
+    m_quit          (false),
+    m_jobs          (nullptr),
+    m_results       (nullptr)
+{
+    if(m_threadsCount <= 0)
+        m_threadsCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_ranges.reset(static_cast<size_t>(m_threadsCount));
+    for(int i = 0; i < m_threadsCount; ++i)
+    {
+        m_ranges[i].next = 0;
+        m_ranges[i].end  = 0;
+    }
+
+    m_threads.reserve(m_threadsCount);
+    for(int i = 0; i < m_threadsCount; ++i)
+        m_threads.emplace_back(&BatchSimulator::workerLoop, this, i);
+}
+
+BatchSimulator::~BatchSimulator()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_startCondition.notify_all();
+
+    for(auto &thread : m_threads)
+        thread.join();
+}
+
+
+// Public Methods //
+std::vector<BatchSimulator::JobResult>
+BatchSimulator::run(const std::vector<Job> &jobs)
+{
+    std::vector<JobResult> results(jobs.size());
+    run(jobs.data(), jobs.size(), results.data());
+
+    return results;
+}
+
+void BatchSimulator::run(const Job *jobs, size_t jobsCount,
+                         JobResult *results)
+{
+    if(jobsCount == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    //Split the jobs in one contiguous range per thread.
+    auto threadsCount = static_cast<size_t>(m_threadsCount);
+    for(size_t i = 0; i < threadsCount; ++i)
+    {
+        m_ranges[i].next = jobsCount *  i      / threadsCount;
+        m_ranges[i].end  = jobsCount * (i + 1) / threadsCount;
+    }
+
+    m_jobs           = jobs;
+    m_results        = results;
+    m_pendingWorkers = m_threadsCount;
+    ++m_generation;
+
+    m_startCondition.notify_all();
+    m_doneCondition.wait(lock, [this]() { return m_pendingWorkers == 0; });
+
+    m_jobs    = nullptr;
+    m_results = nullptr;
+}
+
+int BatchSimulator::getThreadsCount() const
+{
+    return m_threadsCount;
+}
+
+
+// Private Methods //
+void BatchSimulator::workerLoop(int workerIndex)
+{
+    auto generation = uint64_t(0);
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [this, generation]() {
+                return m_quit || m_generation != generation;
+            });
+
+            if(m_quit)
+                return;
+
+            generation = m_generation;
+        }
+
+        //Own range first, then steal from the next ones.
+        for(int i = 0; i < m_threadsCount; ++i)
+            runRange(m_ranges[(workerIndex + i) % m_threadsCount]);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(--m_pendingWorkers == 0)
+                m_doneCondition.notify_one();
+        }
+    }
+}
+
+void BatchSimulator::runRange(Range &range)
+{
+    while(true)
+    {
+        auto begin = range.next.fetch_add(kChunkSize, std::memory_order_relaxed);
+        if(begin >= range.end)
+            return;
+
+        auto end = std::min(begin + kChunkSize, range.end);
+        for(auto i = begin; i < end; ++i)
+            runJob(m_jobs[i], m_results[i]);
+    }
+}
+
+void BatchSimulator::runJob(const Job &job, JobResult &result)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    //Each worker reuses the GameCores of it's own arena.
+    auto core = GameCorePool::acquire(job.width, job.height, job.maxMoves, job.seed);
+
+    //The moves come from outside - applyMoves() validates each
+    //one and stops at the first that can't be done.
+    auto batch = core->applyMoves(job.moves);
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    result.status             = batch.status;
+    result.movesCount         = core->getMovesCount();
+    result.stopReason         = batch.stopReason;
+    result.stopIndex          = batch.stopIndex;
+    result.elapsedNanoseconds = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+    );
+}
@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BoardGenerator.cpp                        //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/BoardGenerator.h"
+//std
+#include <vector>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Public Methods //
+bool BoardGenerator::isSolvable(const FlatBoard &board)
+{
+    auto width = board.getWidth();
+    auto count = board.getCellsCount();
+
+    //Single row or column - Tiles can't pass each other,
+    //so they must be already in order.
+    if(width == 1 || board.getHeight() == 1)
+    {
+        int prevValue = 0;
+        for(int i = 0; i < count; ++i)
+        {
+            auto value = board.getValueAt(i);
+            if(value == 0)
+                continue;
+            if(value < prevValue)
+                return false;
+
+            prevValue = value;
+        }
+        return true;
+    }
+
+    //Each move swaps the empty tile with a neighbor, flipping both
+    //the permutation parity and the parity of the empty tile distance
+    //to it's goal. So they must match to reach the solved Board.
+    //The permutation parity is found by counting the cycles.
+    std::vector<bool> visited(count, false);
+
+    int  cyclesCount = 0;
+    int  emptyIndex  = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(board.getValueAt(i) == 0)
+            emptyIndex = i;
+
+        if(visited[i])
+            continue;
+
+        ++cyclesCount;
+        for(int j = i; !visited[j];
+            j = Heuristics::getGoalIndex(board.getValueAt(j), count))
+        {
+            visited[j] = true;
+        }
+    }
+
+    auto permutationIsOdd = ((count - cyclesCount) % 2) != 0;
+    auto emptyDistance    = (count -1) / width - emptyIndex / width
+                          + (width -1)         - emptyIndex % width;
+
+    return permutationIsOdd == ((emptyDistance % 2) != 0);
+}
+
+void BoardGenerator::generateSeries(FlatBoard &board, const Series &series)
+{
+    CounterRandom rng(series.seed, series.index);
+    generate(board, rng);
+}
+
+void BoardGenerator::setSolved(FlatBoard &board)
+{
+    auto count = board.getCellsCount();
+
+    for(int i = 0; i < count -1; ++i)
+        board.setValueAt(i, i + 1);
+
+    board.setValueAt(count -1, 0);
+}
+
+
+// Private Methods //
+void BoardGenerator::fixParity(FlatBoard &board, bool permutationIsOdd)
+{
+    auto width = board.getWidth();
+    auto count = board.getCellsCount();
+
+    int emptyIndex = 0;
+    while(board.getValueAt(emptyIndex) != 0)
+        ++emptyIndex;
+
+    auto emptyDistance = (count -1) / width - emptyIndex / width
+                       + (width -1)         - emptyIndex % width;
+
+    if(permutationIsOdd == ((emptyDistance % 2) != 0))
+        return;
+
+    //Swapping two tiles flips the permutation parity
+    //without moving the empty tile - Board has at least 4 cells.
+    auto first = (emptyIndex > 1) ? 0 : 2;
+    board.swapValuesAt(first, first + 1);
+}
+
+void BoardGenerator::generateLine(FlatBoard &board, int emptyIndex)
+{
+    auto count = board.getCellsCount();
+
+    int value = 1;
+    for(int i = 0; i < count; ++i)
+        board.setValueAt(i, (i == emptyIndex) ? 0 : value++);
+}
+
+int BoardGenerator::getNeighbors(const FlatBoard &board, int index,
+                                 int neighbors[4])
+{
+    auto width  = board.getWidth();
+    auto height = board.getHeight();
+    auto row    = index / width;
+    auto col    = index % width;
+
+    int neighborsCount = 0;
+    if(row > 0         ) neighbors[neighborsCount++] = index - width;
+    if(row < height -1 ) neighbors[neighborsCount++] = index + width;
+    if(col > 0         ) neighbors[neighborsCount++] = index - 1;
+    if(col < width  -1 ) neighbors[neighborsCount++] = index + 1;
+
+    return neighborsCount;
+}
@@ -0,0 +1,589 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BoardKernels.cpp                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/BoardKernels.h"
+//std
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//Only x86 builds with GCC or Clang have the vector kernels, each
+//one compiled for it's own target so the rest of the code doesn't
+//need -msse2 / -mavx2 flags.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+    #define COREPUZZLE15_KERNELS_X86 1
+    #include <immintrin.h>
+    #define _TARGET_SSE2_ __attribute__((target("sse2")))
+    #define _TARGET_AVX2_ __attribute__((target("avx2")))
+#endif
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int BoardKernels::kMaxVectorCellsCount;
+const int BoardKernels::kMaxPairwiseCellsCount;
+
+
+namespace {
+
+//-1 until the first use - Then the set in use.
+std::atomic<int> g_instructionSet(-1);
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Scalar                                                                     //
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+int countCorrectTilesScalar(const T *cells, int count)
+{
+    int correctCount = 0;
+    for(int i = 0; i < count; ++i)
+        correctCount += (cells[i] == static_cast<uint32_t>(i + 1));
+
+    return correctCount;
+}
+
+template <typename T>
+int manhattanDistanceScalar(const T *cells, int count, int width)
+{
+    int distance = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(cells[i] == 0)
+            continue;
+
+        int goal = cells[i] - 1;
+        distance += std::abs(goal / width - i / width)
+                  + std::abs(goal % width - i % width);
+    }
+
+    return distance;
+}
+
+template <typename T>
+uint64_t countInversionsPairwiseScalar(const T *cells, int count)
+{
+    uint64_t inversions = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(cells[i] == 0)
+            continue;
+
+        for(int j = i + 1; j < count; ++j)
+            inversions += (cells[j] != 0 && cells[j] < cells[i]);
+    }
+
+    return inversions;
+}
+
+//Counts, from the last cell to the first, how many smaller
+//values were already seen - Each one is an inversion.
+template <typename T>
+uint64_t countInversionsFenwick(const T *cells, int count)
+{
+    std::vector<int> tree(count + 1, 0);
+    uint64_t inversions = 0;
+
+    for(int i = count -1; i >= 0; --i)
+    {
+        int value = cells[i];
+        if(value == 0)
+            continue;
+
+        for(int k = value -1; k > 0; k -= k & -k)
+            inversions += tree[k];
+        for(int k = value; k <= count; k += k & -k)
+            ++tree[k];
+    }
+
+    return inversions;
+}
+
+
+#if defined(COREPUZZLE15_KERNELS_X86)
+////////////////////////////////////////////////////////////////////////////////
+// SSE2 - 4 lanes                                                             //
+////////////////////////////////////////////////////////////////////////////////
+_TARGET_SSE2_ inline __m128i load4(const uint8_t *cells)
+{
+    int32_t bytes;
+    std::memcpy(&bytes, cells, sizeof(bytes));
+
+    auto zero = _mm_setzero_si128();
+    auto v    = _mm_cvtsi32_si128(bytes);
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+}
+
+_TARGET_SSE2_ inline __m128i load4(const uint16_t *cells)
+{
+    auto v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(cells));
+    return _mm_unpacklo_epi16(v, _mm_setzero_si128());
+}
+
+_TARGET_SSE2_ inline __m128i load4(const uint32_t *cells)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(cells));
+}
+
+_TARGET_SSE2_ inline int sum4(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+//Splits the lanes of index (as floats) in row and col.
+_TARGET_SSE2_ inline void rowCol4(__m128 index, __m128 width,
+                                  __m128 &row, __m128 &col)
+{
+    auto half = _mm_set1_ps(0.5f);
+    row = _mm_cvtepi32_ps(_mm_cvttps_epi32(
+        _mm_div_ps(_mm_add_ps(index, half), width)
+    ));
+    col = _mm_sub_ps(index, _mm_mul_ps(row, width));
+}
+
+template <typename T>
+_TARGET_SSE2_ int countCorrectTilesSSE2(const T *cells, int count)
+{
+    auto goals = _mm_setr_epi32(1, 2, 3, 4);
+    auto step  = _mm_set1_epi32(4);
+
+    auto sums  = _mm_setzero_si128();
+
+    //Equal lanes are -1, so subtracting counts them.
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        sums  = _mm_sub_epi32(sums, _mm_cmpeq_epi32(load4(cells + i), goals));
+        goals = _mm_add_epi32(goals, step);
+    }
+
+    int correctCount = sum4(sums);
+    for(; i < count; ++i)
+        correctCount += (cells[i] == static_cast<uint32_t>(i + 1));
+
+    return correctCount;
+}
+
+template <typename T>
+_TARGET_SSE2_ int manhattanDistanceSSE2(const T *cells, int count, int width)
+{
+    auto widths  = _mm_set1_ps(static_cast<float>(width));
+    auto indexes = _mm_setr_ps(0, 1, 2, 3);
+    auto step    = _mm_set1_ps(4);
+    auto one     = _mm_set1_epi32(1);
+    auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    auto sums    = _mm_setzero_si128();
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        auto values = load4(cells + i);
+        auto goals  = _mm_cvtepi32_ps(_mm_sub_epi32(values, one));
+
+        __m128 row, col, goalRow, goalCol;
+        rowCol4(indexes, widths, row,     col    );
+        rowCol4(goals,   widths, goalRow, goalCol);
+
+        auto distance = _mm_add_ps(
+            _mm_and_ps(_mm_sub_ps(row, goalRow), absMask),
+            _mm_and_ps(_mm_sub_ps(col, goalCol), absMask)
+        );
+
+        //The empty tile doesn't count.
+        auto notEmpty = _mm_xor_si128(_mm_cmpeq_epi32(values, _mm_setzero_si128()),
+                                      _mm_set1_epi32(-1));
+        sums    = _mm_add_epi32(sums, _mm_and_si128(_mm_cvttps_epi32(distance), notEmpty));
+        indexes = _mm_add_ps(indexes, step);
+    }
+
+    int distance = sum4(sums);
+    for(; i < count; ++i)
+    {
+        if(cells[i] == 0)
+            continue;
+
+        int goal = cells[i] - 1;
+        distance += std::abs(goal / width - i / width)
+                  + std::abs(goal % width - i % width);
+    }
+
+    return distance;
+}
+
+template <typename T>
+_TARGET_SSE2_ uint64_t countInversionsSSE2(const T *cells, int count)
+{
+    //The empty tile is taken as the biggest value,
+    //so it's never smaller than the others.
+    auto zero    = _mm_setzero_si128();
+    auto biggest = _mm_set1_epi32(0x7FFFFFFF);
+
+    uint64_t inversions = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(cells[i] == 0)
+            continue;
+
+        auto value = _mm_set1_epi32(cells[i]);
+        auto sums  = _mm_setzero_si128();
+
+        int j = i + 1;
+        for(; j + 4 <= count; j += 4)
+        {
+            auto others = load4(cells + j);
+            others = _mm_or_si128(others, _mm_and_si128(_mm_cmpeq_epi32(others, zero), biggest));
+            sums   = _mm_sub_epi32(sums, _mm_cmpgt_epi32(value, others));
+        }
+
+        inversions += sum4(sums);
+        for(; j < count; ++j)
+            inversions += (cells[j] != 0 && cells[j] < cells[i]);
+    }
+
+    return inversions;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// AVX2 - 8 lanes                                                             //
+////////////////////////////////////////////////////////////////////////////////
+_TARGET_AVX2_ inline __m256i load8(const uint8_t *cells)
+{
+    return _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(cells))
+    );
+}
+
+_TARGET_AVX2_ inline __m256i load8(const uint16_t *cells)
+{
+    return _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(cells))
+    );
+}
+
+_TARGET_AVX2_ inline __m256i load8(const uint32_t *cells)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cells));
+}
+
+_TARGET_AVX2_ inline int sum8(__m256i v)
+{
+    auto v4 = _mm_add_epi32(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+
+    v4 = _mm_add_epi32(v4, _mm_shuffle_epi32(v4, _MM_SHUFFLE(1, 0, 3, 2)));
+    v4 = _mm_add_epi32(v4, _mm_shuffle_epi32(v4, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v4);
+}
+
+_TARGET_AVX2_ inline void rowCol8(__m256 index, __m256 width,
+                                  __m256 &row, __m256 &col)
+{
+    auto half = _mm256_set1_ps(0.5f);
+    row = _mm256_round_ps(_mm256_div_ps(_mm256_add_ps(index, half), width),
+                          _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    col = _mm256_sub_ps(index, _mm256_mul_ps(row, width));
+}
+
+template <typename T>
+_TARGET_AVX2_ int countCorrectTilesAVX2(const T *cells, int count)
+{
+    auto goals = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+    auto step  = _mm256_set1_epi32(8);
+
+    auto sums  = _mm256_setzero_si256();
+
+    //Equal lanes are -1, so subtracting counts them.
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        sums  = _mm256_sub_epi32(sums, _mm256_cmpeq_epi32(load8(cells + i), goals));
+        goals = _mm256_add_epi32(goals, step);
+    }
+
+    int correctCount = sum8(sums);
+    for(; i < count; ++i)
+        correctCount += (cells[i] == static_cast<uint32_t>(i + 1));
+
+    return correctCount;
+}
+
+template <typename T>
+_TARGET_AVX2_ int manhattanDistanceAVX2(const T *cells, int count, int width)
+{
+    auto widths  = _mm256_set1_ps(static_cast<float>(width));
+    auto indexes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    auto step    = _mm256_set1_ps(8);
+    auto one     = _mm256_set1_epi32(1);
+    auto zero    = _mm256_setzero_si256();
+    auto sums    = _mm256_setzero_si256();
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        auto values = load8(cells + i);
+        auto goals  = _mm256_cvtepi32_ps(_mm256_sub_epi32(values, one));
+
+        __m256 row, col, goalRow, goalCol;
+        rowCol8(indexes, widths, row,     col    );
+        rowCol8(goals,   widths, goalRow, goalCol);
+
+        auto distance = _mm256_add_epi32(
+            _mm256_abs_epi32(_mm256_cvttps_epi32(_mm256_sub_ps(row, goalRow))),
+            _mm256_abs_epi32(_mm256_cvttps_epi32(_mm256_sub_ps(col, goalCol)))
+        );
+
+        //The empty tile doesn't count.
+        sums    = _mm256_add_epi32(sums, _mm256_andnot_si256(_mm256_cmpeq_epi32(values, zero), distance));
+        indexes = _mm256_add_ps(indexes, step);
+    }
+
+    int distance = sum8(sums);
+    for(; i < count; ++i)
+    {
+        if(cells[i] == 0)
+            continue;
+
+        int goal = cells[i] - 1;
+        distance += std::abs(goal / width - i / width)
+                  + std::abs(goal % width - i % width);
+    }
+
+    return distance;
+}
+
+template <typename T>
+_TARGET_AVX2_ uint64_t countInversionsAVX2(const T *cells, int count)
+{
+    //The empty tile is taken as the biggest value,
+    //so it's never smaller than the others.
+    auto zero    = _mm256_setzero_si256();
+    auto biggest = _mm256_set1_epi32(0x7FFFFFFF);
+
+    uint64_t inversions = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        if(cells[i] == 0)
+            continue;
+
+        auto value = _mm256_set1_epi32(cells[i]);
+        auto sums  = _mm256_setzero_si256();
+
+        int j = i + 1;
+        for(; j + 8 <= count; j += 8)
+        {
+            auto others = load8(cells + j);
+            others = _mm256_blendv_epi8(others, biggest, _mm256_cmpeq_epi32(others, zero));
+            sums   = _mm256_sub_epi32(sums, _mm256_cmpgt_epi32(value, others));
+        }
+
+        inversions += sum8(sums);
+        for(; j < count; ++j)
+            inversions += (cells[j] != 0 && cells[j] < cells[i]);
+    }
+
+    return inversions;
+}
+#endif // defined(COREPUZZLE15_KERNELS_X86) //
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Dispatch                                                                   //
+////////////////////////////////////////////////////////////////////////////////
+BoardKernels::InstructionSet detectInstructionSet()
+{
+#if defined(COREPUZZLE15_KERNELS_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        return BoardKernels::InstructionSet::AVX2;
+    if(__builtin_cpu_supports("sse2"))
+        return BoardKernels::InstructionSet::SSE2;
+#endif
+
+    return BoardKernels::InstructionSet::Scalar;
+}
+
+//Picks the set for a board - The huge ones always go scalar.
+BoardKernels::InstructionSet instructionSetFor(const FlatBoard &board)
+{
+    if(board.getCellsCount() >= BoardKernels::kMaxVectorCellsCount)
+        return BoardKernels::InstructionSet::Scalar;
+
+    return BoardKernels::getInstructionSet();
+}
+
+template <typename T>
+int countCorrectTilesOf(const T *cells, int count,
+                        BoardKernels::InstructionSet instructionSet)
+{
+#if defined(COREPUZZLE15_KERNELS_X86)
+    switch(instructionSet)
+    {
+        case BoardKernels::InstructionSet::AVX2 : return countCorrectTilesAVX2(cells, count);
+        case BoardKernels::InstructionSet::SSE2 : return countCorrectTilesSSE2(cells, count);
+        default: break;
+    }
+#endif
+
+    (void)instructionSet;
+    return countCorrectTilesScalar(cells, count);
+}
+
+template <typename T>
+int manhattanDistanceOf(const T *cells, int count, int width,
+                        BoardKernels::InstructionSet instructionSet)
+{
+#if defined(COREPUZZLE15_KERNELS_X86)
+    switch(instructionSet)
+    {
+        case BoardKernels::InstructionSet::AVX2 : return manhattanDistanceAVX2(cells, count, width);
+        case BoardKernels::InstructionSet::SSE2 : return manhattanDistanceSSE2(cells, count, width);
+        default: break;
+    }
+#endif
+
+    (void)instructionSet;
+    return manhattanDistanceScalar(cells, count, width);
+}
+
+template <typename T>
+uint64_t countInversionsOf(const T *cells, int count,
+                           BoardKernels::InstructionSet instructionSet)
+{
+    if(count > BoardKernels::kMaxPairwiseCellsCount)
+        return countInversionsFenwick(cells, count);
+
+#if defined(COREPUZZLE15_KERNELS_X86)
+    switch(instructionSet)
+    {
+        case BoardKernels::InstructionSet::AVX2 : return countInversionsAVX2(cells, count);
+        case BoardKernels::InstructionSet::SSE2 : return countInversionsSSE2(cells, count);
+        default: break;
+    }
+#endif
+
+    (void)instructionSet;
+    return countInversionsPairwiseScalar(cells, count);
+}
+
+} //namespace
+
+
+// Public Methods //
+BoardKernels::InstructionSet BoardKernels::getBestInstructionSet()
+{
+    static const InstructionSet s_best = detectInstructionSet();
+    return s_best;
+}
+
+BoardKernels::InstructionSet BoardKernels::getInstructionSet()
+{
+    auto instructionSet = g_instructionSet.load(std::memory_order_relaxed);
+    if(instructionSet == -1)
+    {
+        instructionSet = static_cast<int>(getBestInstructionSet());
+        g_instructionSet.store(instructionSet, std::memory_order_relaxed);
+    }
+
+    return static_cast<InstructionSet>(instructionSet);
+}
+
+void BoardKernels::setInstructionSet(InstructionSet instructionSet)
+{
+    auto best = getBestInstructionSet();
+    if(static_cast<int>(instructionSet) > static_cast<int>(best))
+        instructionSet = best;
+
+    g_instructionSet.store(static_cast<int>(instructionSet),
+                           std::memory_order_relaxed);
+}
+
+
+int BoardKernels::countCorrectTiles(const FlatBoard &board)
+{
+    auto count          = board.getCellsCount();
+    auto instructionSet = instructionSetFor(board);
+
+    switch(board.getCellSize())
+    {
+        case 1 : return countCorrectTilesOf(board.getCells<uint8_t >(), count, instructionSet);
+        case 2 : return countCorrectTilesOf(board.getCells<uint16_t>(), count, instructionSet);
+        default: return countCorrectTilesOf(board.getCells<uint32_t>(), count, instructionSet);
+    }
+}
+
+bool BoardKernels::isSolved(const FlatBoard &board)
+{
+    return countCorrectTiles(board) == board.getCellsCount() -1;
+}
+
+int BoardKernels::manhattanDistance(const FlatBoard &board)
+{
+    auto width          = board.getWidth();
+    auto count          = board.getCellsCount();
+    auto instructionSet = instructionSetFor(board);
+
+    switch(board.getCellSize())
+    {
+        case 1 : return manhattanDistanceOf(board.getCells<uint8_t >(), count, width, instructionSet);
+        case 2 : return manhattanDistanceOf(board.getCells<uint16_t>(), count, width, instructionSet);
+        default: return manhattanDistanceOf(board.getCells<uint32_t>(), count, width, instructionSet);
+    }
+}
+
+uint64_t BoardKernels::countInversions(const FlatBoard &board)
+{
+    auto count          = board.getCellsCount();
+    auto instructionSet = instructionSetFor(board);
+
+    switch(board.getCellSize())
+    {
+        case 1 : return countInversionsOf(board.getCells<uint8_t >(), count, instructionSet);
+        case 2 : return countInversionsOf(board.getCells<uint16_t>(), count, instructionSet);
+        default: return countInversionsOf(board.getCells<uint32_t>(), count, instructionSet);
+    }
+}
@@ -0,0 +1,229 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        BoardRenderer.cpp                         //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/BoardRenderer.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+namespace {
+
+//"00" to "99" - Two digits are written at once.
+const char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+int countDigits(uint32_t value)
+{
+    int count = 1;
+    while(value >= 10)
+    {
+        value /= 10;
+        ++count;
+    }
+    return count;
+}
+
+//Writes value in the digitsCount chars that end at end,
+//zero padded - value must fit in digitsCount.
+inline void writeDigits(char *end, uint32_t value, int digitsCount)
+{
+    while(digitsCount >= 2)
+    {
+        auto pair = (value % 100) * 2;
+        value /= 100;
+
+        end -= 2;
+        end[0] = kDigitPairs[pair    ];
+        end[1] = kDigitPairs[pair + 1];
+        digitsCount -= 2;
+    }
+
+    if(digitsCount == 1)
+        end[-1] = static_cast<char>('0' + value % 10);
+}
+
+template <typename T>
+size_t renderAscii(const T *cells, int width, int height,
+                   char *buffer, size_t size)
+{
+    auto required = BoardRenderer::getAsciiSize(width, height);
+    if(size < required)
+        return 0;
+
+    auto digits = BoardRenderer::getDigitsCount(width, height);
+    auto out    = buffer;
+
+    for(int y = 0; y < height; ++y)
+    {
+        for(int x = 0; x < width; ++x)
+        {
+            out += digits;
+            writeDigits(out, static_cast<uint32_t>(*cells++), digits);
+            *out++ = ' ';
+        }
+        *out++ = '\n';
+    }
+
+    return required;
+}
+
+char* writeDeltaCell(char *out, const FlatBoard &board,
+                     const CoreCoord::Coord &coord)
+{
+    auto index = static_cast<uint32_t>(board.getIndex(coord));
+    auto value = static_cast<uint32_t>(board.getValueAt(coord));
+
+    auto indexDigits = countDigits(index);
+    out += indexDigits;
+    writeDigits(out, index, indexDigits);
+    *out++ = ':';
+
+    auto valueDigits = countDigits(value);
+    out += valueDigits;
+    writeDigits(out, value, valueDigits);
+    *out++ = ' ';
+
+    return out;
+}
+
+} //namespace
+
+
+// Public Methods //
+int BoardRenderer::getDigitsCount(int width, int height)
+{
+    //Same as GameCore::ascii() always did - floor(log10(count)) + 1.
+    return countDigits(static_cast<uint32_t>(width * height));
+}
+
+size_t BoardRenderer::getAsciiSize(int width, int height)
+{
+    auto digits = static_cast<size_t>(getDigitsCount(width, height));
+    return static_cast<size_t>(height) * (width * (digits + 1) + 1);
+}
+
+
+size_t BoardRenderer::ascii(const FlatBoard &board, char *buffer, size_t size)
+{
+    auto width  = board.getWidth ();
+    auto height = board.getHeight();
+
+    switch(board.getCellSize())
+    {
+        case 1 : return renderAscii(board.getCells<uint8_t >(), width, height, buffer, size);
+        case 2 : return renderAscii(board.getCells<uint16_t>(), width, height, buffer, size);
+        default: return renderAscii(board.getCells<uint32_t>(), width, height, buffer, size);
+    }
+}
+
+void BoardRenderer::ascii(const FlatBoard &board, std::string &str)
+{
+    str.resize(getAsciiSize(board.getWidth(), board.getHeight()));
+    ascii(board, &str[0], str.size());
+}
+
+size_t BoardRenderer::ascii(const uint8_t *cells, int width, int height,
+                            char *buffer, size_t size)
+{
+    return renderAscii(cells, width, height, buffer, size);
+}
+
+size_t BoardRenderer::ascii(const uint16_t *cells, int width, int height,
+                            char *buffer, size_t size)
+{
+    return renderAscii(cells, width, height, buffer, size);
+}
+
+
+size_t BoardRenderer::getMaxDeltaSize(const FlatBoard &board,
+                                      const GameCore::MoveResult &result)
+{
+    if(result.currentCoords.empty())
+        return 0;
+
+    //The moved tiles and the new empty cell, each with the max digits
+    //of an index and a value, ':' and ' ' - Then the '\n'.
+    auto digits = static_cast<size_t>(
+        countDigits(static_cast<uint32_t>(board.getCellsCount()))
+    );
+    return (result.currentCoords.size() + 1) * (2 * digits + 2) + 1;
+}
+
+size_t BoardRenderer::delta(const FlatBoard &board,
+                            const GameCore::MoveResult &result,
+                            char *buffer, size_t size)
+{
+    auto required = getMaxDeltaSize(board, result);
+    if(required == 0 || size < required)
+        return 0;
+
+    auto out = buffer;
+    for(const auto &coord : result.currentCoords)
+        out = writeDeltaCell(out, board, coord);
+
+    //Where the last tile was is the empty cell now.
+    out = writeDeltaCell(out, board, result.previousCoords.back());
+
+    out[-1] = '\n'; //Replaces the last ' '.
+    return static_cast<size_t>(out - buffer);
+}
+
+void BoardRenderer::delta(const FlatBoard &board,
+                          const GameCore::MoveResult &result,
+                          std::string &str)
+{
+    str.resize(getMaxDeltaSize(board, result));
+    if(str.empty())
+        return;
+
+    str.resize(delta(board, result, &str[0], str.size()));
+}
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        FlatBoard.cpp                             //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/FlatBoard.h"
+//std
+#include <algorithm>
+#include <limits>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// CTOR/DTOR //
+FlatBoard::FlatBoard() :
+    m_width   (0),
+    m_height  (0),
+    m_cellSize(1)
+{
+    //Empty...
+}
+
+FlatBoard::FlatBoard(int width, int height) :
+    FlatBoard()
+{
+    resize(width, height);
+}
+
+
+// Public Methods //
+void FlatBoard::resize(int width, int height)
+{
+    m_width    = width;
+    m_height   = height;
+    m_cellSize = cellSizeFor(width * height);
+
+    //Only the buffer of the current cell size holds memory.
+    //clear() keeps the capacity, so a board that is resized
+    //to the same size class doesn't allocate again.
+    m_cells8 .clear();
+    m_cells16.clear();
+    m_cells32.clear();
+
+    switch(m_cellSize)
+    {
+        case 1 : m_cells8 .resize(getCellsCount(), 0); break;
+        case 2 : m_cells16.resize(getCellsCount(), 0); break;
+        default: m_cells32.resize(getCellsCount(), 0); break;
+    }
+}
+
+void FlatBoard::copyTo(std::vector<std::vector<int>> &board) const
+{
+    board.resize(m_height);
+    for(int i = 0; i < m_height; ++i)
+    {
+        auto &row = board[i];
+        row.resize(m_width);
+
+        for(int j = 0; j < m_width; ++j)
+            row[j] = getValueAt(i * m_width + j);
+    }
+}
+
+
+// Private Methods //
+int FlatBoard::cellSizeFor(int cellsCount)
+{
+    //The biggest value stored is (cellsCount - 1).
+    if(cellsCount - 1 <= std::numeric_limits<uint8_t>::max())
+        return 1;
+    if(cellsCount - 1 <= std::numeric_limits<uint16_t>::max())
+        return 2;
+
+    return 4;
+}
@@ -42,10 +42,13 @@
 #include "../include/GameCore.h"
 //std
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
-#include <cmath>
-#include <iostream>
+#include <cstring>
+//CorePuzzle15
+#include "../include/BoardKernels.h"
+#include "../include/BoardRenderer.h"
+#include "../include/Metrics.h"
+#include "../include/MoveLog.h"
+#include "../include/Trace.h"
 using namespace std;
 
 //Usings
@@ -57,71 +60,246 @@ const int GameCore::kUnlimitedMoves = -1;
 const int GameCore::kEmptyValue     = 0;
 
 
+// Inner Types //
+bool GameCore::Snapshot::operator ==(const Snapshot &other) const
+{
+    return width         == other.width
+        && height        == other.height
+        && status        == other.status
+        && movesCount    == other.movesCount
+        && maxMovesCount == other.maxMovesCount
+        && seed          == other.seed
+        && std::equal(std::begin(cells), std::end(cells), std::begin(other.cells));
+}
+
+bool GameCore::Snapshot::operator !=(const Snapshot &other) const
+{
+    return !(*this == other);
+}
+
+
 // CTOR/DTOR //
 GameCore::GameCore(int width, int height, int maxMoves, int seed) :
     //m_board - Init in initBoard().
-    m_emptyCoord   (-1, -1),
-    m_status       (CoreGame::Status::Continue),
-    m_movesCount   (0),
-    m_maxMovesCount(maxMoves),
-    m_random       (seed)
+    m_emptyCoord       (-1, -1),
+    m_emptyIndex       (-1),
+    m_moveTable        (nullptr),
+    m_hasLegacyBoard   (false),
+    m_status           (CoreGame::Status::Continue),
+    m_movesCount       (0),
+    m_maxMovesCount    (maxMoves),
+    m_correctTilesCount(0),
+    m_hash             (0),
+    m_boardSource      (BoardSource::Seed),
+    m_difficulty       (0, 0),
+    m_series           (0, 0),
+    m_trackHeuristics  (false),
+    m_moveLog          (nullptr),
+    m_random           (seed)
+{
+    initBoard(width, height);
+}
+
+GameCore::GameCore(int width, int height,
+                   const BoardGenerator::Difficulty &difficulty,
+                   int maxMoves, int seed) :
+    //m_board - Init in initBoard().
+    m_emptyCoord       (-1, -1),
+    m_emptyIndex       (-1),
+    m_moveTable        (nullptr),
+    m_hasLegacyBoard   (false),
+    m_status           (CoreGame::Status::Continue),
+    m_movesCount       (0),
+    m_maxMovesCount    (maxMoves),
+    m_correctTilesCount(0),
+    m_hash             (0),
+    m_boardSource      (BoardSource::Difficulty),
+    m_difficulty       (difficulty),
+    m_series           (0, 0),
+    m_trackHeuristics  (false),
+    m_moveLog          (nullptr),
+    m_random           (seed)
+{
+    initBoard(width, height);
+}
+
+GameCore::GameCore(int width, int height,
+                   const BoardGenerator::Series &series,
+                   int maxMoves) :
+    //m_board - Init in initBoard().
+    m_emptyCoord       (-1, -1),
+    m_emptyIndex       (-1),
+    m_moveTable        (nullptr),
+    m_hasLegacyBoard   (false),
+    m_status           (CoreGame::Status::Continue),
+    m_movesCount       (0),
+    m_maxMovesCount    (maxMoves),
+    m_correctTilesCount(0),
+    m_hash             (0),
+    m_boardSource      (BoardSource::Series),
+    m_difficulty       (0, 0),
+    m_series           (series),
+    m_trackHeuristics  (false),
+    m_moveLog          (nullptr),
+    m_random           (0)
 {
     initBoard(width, height);
 }
 
 
 // Public Methods //
+void GameCore::reset(int width, int height, int maxMoves, int seed)
+{
+    resetState(maxMoves, seed);
+    m_boardSource = BoardSource::Seed;
+
+    initBoard(width, height);
+}
+
+void GameCore::reset(int width, int height,
+                     const BoardGenerator::Difficulty &difficulty,
+                     int maxMoves, int seed)
+{
+    resetState(maxMoves, seed);
+    m_boardSource = BoardSource::Difficulty;
+    m_difficulty  = difficulty;
+
+    initBoard(width, height);
+}
+
+void GameCore::reset(int width, int height,
+                     const BoardGenerator::Series &series,
+                     int maxMoves)
+{
+    resetState(maxMoves, 0);
+    m_boardSource = BoardSource::Series;
+    m_series      = series;
+
+    initBoard(width, height);
+}
+
+void GameCore::reset(const FlatBoard &board, int maxMoves, int seed)
+{
+    resetState(maxMoves, seed);
+    m_boardSource = BoardSource::Given;
+
+    initBoard(board.getWidth(), board.getHeight(), &board);
+}
+
+
 GameCore::MoveResult GameCore::move(const CoreCoord::Coord &coord)
 {
     MoveResult result;
+    slide(coord, &result);
 
-    //Game is already over - Don't do anything...
+    return result;
+}
+
+void GameCore::move(const CoreCoord::Coord &coord, MoveResult &result)
+{
+    result.moveDirection = MoveResult::Direction::None;
+    result.previousCoords.clear();
+    result.currentCoords.clear();
+
+    slide(coord, &result);
+}
+
+GameCore::MoveSummary GameCore::moveFast(const CoreCoord::Coord &coord)
+{
+    return slide(coord, nullptr);
+}
+
+GameCore::MoveSummary GameCore::tryMove(MoveResult::Direction direction)
+{
+    if(direction == MoveResult::Direction::None)
+        return MoveSummary();
+
+    //There's no tile at that side - Don't do anything...
+    auto index = m_moveTable->getNeighbor(m_emptyIndex, static_cast<int>(direction));
+    if(index == MoveTable::kNoNeighbor)
+        return MoveSummary();
+
+    return slide(m_moveTable->getCoord(index), nullptr);
+}
+
+uint8_t GameCore::getLegalMoves() const
+{
     if(m_status != CoreGame::Status::Continue)
-        return result;
+        return 0;
 
-    //Coord is the empty coord - Don't do anything...
-    if(m_emptyCoord == coord)
-        return result;
+    return m_moveTable->getNeighborsMask(m_emptyIndex);
+}
 
-    //Coord isn't at same row or col from the empty coord.
-    //Cannot move - Don't do anything...
-    if(!m_emptyCoord.isSameX(coord) && !m_emptyCoord.isSameY(coord))
-        return result;
-
-    //Set Increment coord.
-    CoreCoord::Coord incrCoord;
-
-    //Since all logic is equal, only changing is the
-    //method's name that will be called, I think that's a good use for a macro.
-    //See (A Arte de Escrever Programas Legiveis - ISBN 978-85-7522-294-2)
-    //Chapter 8, pag 105 for more :)
-#define _DECIDE_DIR_COORD_(_cond_, _dir_)                    \
-    if(_cond_) {                                             \
-        incrCoord = CoreCoord::Coord::_dir_();               \
-        result.moveDirection = MoveResult::Direction::_dir_; \
-    }
 
-    _DECIDE_DIR_COORD_(coord.x < m_emptyCoord.x, Left );
-    _DECIDE_DIR_COORD_(coord.x > m_emptyCoord.x, Right);
-    _DECIDE_DIR_COORD_(coord.y < m_emptyCoord.y, Up   );
-    _DECIDE_DIR_COORD_(coord.y > m_emptyCoord.y, Down );
+GameCore::BatchResult GameCore::applyMoves(const CoreCoord::Coord *coords,
+                                           size_t count,
+                                           BatchMode mode)
+{
+    return applyMovesTemplate(coords, count, mode);
+}
 
-    for(auto currCoord = m_emptyCoord;
-        currCoord != coord;
-        currCoord += incrCoord)
-    {
-        result.previousCoords.push_back(currCoord + incrCoord);
-        result.currentCoords.push_back (currCoord);
+GameCore::BatchResult GameCore::applyMoves(const CoreCoord::Coord::Vec &coords,
+                                           BatchMode mode)
+{
+    return applyMovesTemplate(coords.data(), coords.size(), mode);
+}
 
-        swapValuesAt(currCoord + incrCoord, currCoord);
-    }
+GameCore::BatchResult GameCore::applyMoves(const MoveResult::Direction *directions,
+                                           size_t count,
+                                           BatchMode mode)
+{
+    return applyMovesTemplate(directions, count, mode);
+}
 
-    ++m_movesCount;
-    checkStatus();
+GameCore::BatchResult GameCore::applyMoves(const std::vector<MoveResult::Direction> &directions,
+                                           BatchMode mode)
+{
+    return applyMovesTemplate(directions.data(), directions.size(), mode);
+}
 
-    m_emptyCoord = coord;
-    return result;
-#undef _DECIDE_DIR_COORD_ //We don't want this poluting...
+
+GameCore::MoveSummary GameCore::undo()
+{
+    return undo(nullptr);
+}
+
+void GameCore::undo(MoveResult &result)
+{
+    result.moveDirection = MoveResult::Direction::None;
+    result.previousCoords.clear();
+    result.currentCoords.clear();
+
+    undo(&result);
+}
+
+GameCore::MoveSummary GameCore::redo()
+{
+    return redo(nullptr);
+}
+
+void GameCore::redo(MoveResult &result)
+{
+    result.moveDirection = MoveResult::Direction::None;
+    result.previousCoords.clear();
+    result.currentCoords.clear();
+
+    redo(&result);
+}
+
+bool GameCore::canUndo() const
+{
+    return !m_undoIndexes.empty();
+}
+
+bool GameCore::canRedo() const
+{
+    return !m_redoIndexes.empty();
+}
+
+void GameCore::clearHistory()
+{
+    m_undoIndexes.clear();
+    m_redoIndexes.clear();
 }
 
 
@@ -131,13 +309,25 @@ const CoreCoord::Coord& GameCore::getEmptyValueCoord()
 }
 
 const GameCore::Board& GameCore::getBoard() const
+{
+    //Built once - Then the moves keep it in sync.
+    if(!m_hasLegacyBoard)
+    {
+        m_board.copyTo(m_legacyBoard);
+        m_hasLegacyBoard = true;
+    }
+
+    return m_legacyBoard;
+}
+
+const FlatBoard& GameCore::getFlatBoard() const
 {
     return m_board;
 }
 
 int GameCore::getValueAt(const CoreCoord::Coord &coord) const
 {
-    return m_board[coord.y][coord.x];
+    return m_board.getValueAt(coord);
 }
 
 
@@ -166,14 +356,161 @@ int GameCore::getRemainingMovesCount() const
 }
 
 
+int GameCore::getCorrectTileCount() const
+{
+    return m_correctTilesCount;
+}
+
+
+uint64_t GameCore::getHash() const
+{
+    return m_hash;
+}
+
+
+void GameCore::setHeuristicsTracking(bool enabled)
+{
+    m_trackHeuristics = enabled;
+    if(enabled)
+        m_heuristics.reset(m_board);
+}
+
+bool GameCore::isTrackingHeuristics() const
+{
+    return m_trackHeuristics;
+}
+
+int GameCore::getHeuristic(Heuristics::Kind kind) const
+{
+    if(m_trackHeuristics)
+        return m_heuristics.get(kind);
+
+    return Heuristics::evaluate(m_board, kind);
+}
+
+bool GameCore::snapshot(Snapshot &snapshot) const
+{
+    auto count = m_board.getCellsCount();
+    if(count > Snapshot::kMaxCellsCount)
+        return false;
+
+    snapshot.width         = static_cast<uint8_t>(getWidth ());
+    snapshot.height        = static_cast<uint8_t>(getHeight());
+    snapshot.status        = m_status;
+    snapshot.movesCount    = m_movesCount;
+    snapshot.maxMovesCount = m_maxMovesCount;
+    snapshot.seed          = getSeed();
+
+    //Pack the cells one after other - A cell may be split
+    //between two words when the bits don't divide 64.
+    auto bits = bitsPerCell(count);
+
+    std::fill(std::begin(snapshot.cells), std::end(snapshot.cells), 0);
+    for(int i = 0; i < count; ++i)
+    {
+        auto value = static_cast<uint64_t>(m_board.getValueAt(i));
+        auto bit   = i * bits;
+        auto word  = bit / 64;
+        auto shift = bit % 64;
+
+        snapshot.cells[word] |= value << shift;
+        if(shift + bits > 64)
+            snapshot.cells[word + 1] |= value >> (64 - shift);
+    }
+
+    return true;
+}
+
+void GameCore::restore(const Snapshot &snapshot)
+{
+    if(snapshot.width  != getWidth() || snapshot.height != getHeight())
+    {
+        m_board.resize(snapshot.width, snapshot.height);
+        m_moveTable = &MoveTable::get(snapshot.width, snapshot.height);
+    }
+
+    if(snapshot.seed != getSeed())
+        m_random = CoreRandom::Random(snapshot.seed);
+
+    setStatus(snapshot.status);
+    m_movesCount    = snapshot.movesCount;
+    m_maxMovesCount = snapshot.maxMovesCount;
+
+    auto count = m_board.getCellsCount();
+    auto bits  = bitsPerCell(count);
+    auto mask  = (1ull << bits) -1;
+
+    for(int i = 0; i < count; ++i)
+    {
+        auto bit   = i * bits;
+        auto word  = bit / 64;
+        auto shift = bit % 64;
+
+        auto value = snapshot.cells[word] >> shift;
+        if(shift + bits > 64)
+            value |= snapshot.cells[word + 1] << (64 - shift);
+
+        value &= mask;
+        m_board.setValueAt(i, static_cast<int>(value));
+
+        if(value == kEmptyValue)
+        {
+            m_emptyCoord = m_board.getCoord(i);
+            m_emptyIndex = i;
+        }
+    }
+
+    countCorrectTiles();
+    m_hash = Zobrist::hash(m_board);
+
+    if(m_hasLegacyBoard)
+        m_board.copyTo(m_legacyBoard);
+
+    if(m_trackHeuristics)
+        m_heuristics.reset(m_board);
+
+    m_moveLog = nullptr;
+    clearHistory();
+}
+
+
+void GameCore::setMoveLog(MoveLog *moveLog)
+{
+    m_moveLog = moveLog;
+    if(!m_moveLog)
+        return;
+
+    switch(m_boardSource)
+    {
+        case BoardSource::Difficulty:
+            m_moveLog->begin(m_board, m_difficulty, getSeed(), m_maxMovesCount);
+            break;
+
+        case BoardSource::Series:
+            m_moveLog->begin(getWidth(), getHeight(), m_series, m_maxMovesCount);
+            break;
+
+        //Seed and Given - The cells are in the header.
+        default:
+            m_moveLog->begin(m_board, getSeed(), m_maxMovesCount);
+            break;
+    }
+}
+
+MoveLog* GameCore::getMoveLog() const
+{
+    return m_moveLog;
+}
+
+
 int GameCore::getWidth() const
 {
-    return m_board[0].size();
+    return m_board.getWidth();
 }
 
 int GameCore::getHeight() const
 {
-    return m_board.size();
+    return m_board.getHeight();
 }
 
 
@@ -190,66 +527,352 @@ bool GameCore::isUsingRandomSeed() const
 
 std::string GameCore::ascii() const
 {
-    std::stringstream ss;
-    auto digits = static_cast<int>(std::log10(getWidth() * getHeight())) + 1;
+    std::string str;
+    ascii(str);
 
-    for(const auto &line : m_board)
-    {
-        for(const auto &value : line)
-            ss << std::setw(digits) << std::setfill('0') << value << " ";
-        ss << std::endl;
-    };
+    return str;
+}
 
-    return ss.str();
+void GameCore::ascii(std::string &str) const
+{
+    BoardRenderer::ascii(m_board, str);
 }
 
 // Private Methods //
-void GameCore::initBoard(int width, int height)
+int GameCore::bitsPerCell(int cellsCount)
 {
-    //Init a temp vector with all values.
-    std::vector<int> tmp(width * height);
-    std::iota(std::begin(tmp), std::end(tmp), 0);
+    //Enough bits for the biggest value (cellsCount - 1).
+    int bits = 1;
+    while((1 << bits) < cellsCount)
+        ++bits;
 
-    //Shuffle the temp vector.
-    std::shuffle(std::begin(tmp), std::end(tmp),
-                 m_random.getNumberGenerator());
+    return bits;
+}
 
+GameCore::MoveSummary GameCore::slide(const CoreCoord::Coord &coord,
+                                      MoveResult *result)
+{
+    //Game is already over - Don't do anything...
+    if(m_status != CoreGame::Status::Continue)
+    {
+        COREPUZZLE15_METRICS_ADD(RejectedGameOverCount);
+        return MoveSummary();
+    }
 
-    //Add the values into the board.
-    m_board.reserve(height);
-    for(int i = 0; i < height; ++i)
+    //Coord is the empty coord - Don't do anything...
+    if(m_emptyCoord == coord)
+    {
+        COREPUZZLE15_METRICS_ADD(RejectedEmptyCoordCount);
+        return MoveSummary();
+    }
+
+    //Coord isn't at same row or col from the empty coord.
+    //Cannot move - Don't do anything...
+    if(!m_emptyCoord.isSameX(coord) && !m_emptyCoord.isSameY(coord))
     {
-        m_board.push_back(std::vector<int>(width));
-        std::copy_n(std::begin(tmp) + i * width,
-                    width,
-                    std::begin(m_board[i]));
+        COREPUZZLE15_METRICS_ADD(RejectedNotInLineCount);
+        return MoveSummary();
+    }
 
+    auto summary = commitMove(coord, result);
+    checkStatus();
 
-        //Try find the kEmptyValue in this row...
-        //If it was found update the emptyCoord
-        //i.e that coord will contain the kEmptyValue at start.
-        if(m_emptyCoord.y == -1 && m_emptyCoord.x == -1)
+    return summary;
+}
+
+GameCore::MoveSummary GameCore::commitMove(const CoreCoord::Coord &coord,
+                                           MoveResult *result)
+{
+    //Moving back to it is the inverse move.
+    m_undoIndexes.push_back(m_emptyIndex);
+    m_redoIndexes.clear();
+
+    auto summary = shiftTiles(coord, result);
+
+    if(m_moveLog)
+        m_moveLog->record(summary.moveDirection, summary.tilesCount);
+
+    COREPUZZLE15_TRACE(onMove(*this, summary));
+    COREPUZZLE15_METRICS_ADD    (MovesCount);
+    COREPUZZLE15_METRICS_OBSERVE(TilesShifted, summary.tilesCount);
+
+    ++m_movesCount;
+
+    return summary;
+}
+
+template <typename T>
+GameCore::BatchResult GameCore::applyMovesTemplate(const T *moves,
+                                                   size_t count,
+                                                   BatchMode mode)
+{
+    BatchResult batch;
+
+    m_undoIndexes.reserve(m_undoIndexes.size() + count);
+
+    size_t i = 0;
+    for(; i < count; ++i)
+    {
+        //Same counters of slide() - commitMove() does the rest.
+        if(m_status != CoreGame::Status::Continue)
+        {
+            COREPUZZLE15_METRICS_ADD(RejectedGameOverCount);
+            batch.stopReason = BatchResult::StopReason::GameOver;
+            break;
+        }
+
+        CoreCoord::Coord coord;
+        if(!getMoveCoord(moves[i], coord))
         {
-            auto it = std::find(std::begin(m_board[i]),
-                                std::end  (m_board[i]),
-                                kEmptyValue);
-
-            if(it != std::end(m_board[i]))
-            {
-                m_emptyCoord.y = i;
-                m_emptyCoord.x = static_cast<int>(it - std::begin(m_board[i]));
-                cout << static_cast<int>(it - std::begin(m_board[i])) << endl;
-            }
+            batch.stopReason = BatchResult::StopReason::InvalidMove;
+            break;
         }
-    }//for(int i = 0; i < height; ++i)
+
+        batch.tilesCount += commitMove(coord, nullptr).tilesCount;
+
+        //The moves cap ends the game in both modes.
+        if(mode == BatchMode::StopAtGameOver || getRemainingMovesCount() == 0)
+            checkStatus();
+    }
+
+    if(mode == BatchMode::CheckAtEnd && i > 0)
+        checkStatus();
+
+    batch.stopIndex = i;
+    batch.status    = m_status;
+
+    return batch;
+}
+
+bool GameCore::getMoveCoord(const CoreCoord::Coord &coord,
+                            CoreCoord::Coord &moveCoord) const
+{
+    if(coord.x < 0 || coord.x >= getWidth () ||
+       coord.y < 0 || coord.y >= getHeight())
+    {
+        return false;
+    }
+
+    //Must be in the same row or col of the empty
+    //tile, and not the empty tile itself.
+    if(m_emptyCoord == coord)
+    {
+        COREPUZZLE15_METRICS_ADD(RejectedEmptyCoordCount);
+        return false;
+    }
+
+    if(!m_emptyCoord.isSameX(coord) && !m_emptyCoord.isSameY(coord))
+    {
+        COREPUZZLE15_METRICS_ADD(RejectedNotInLineCount);
+        return false;
+    }
+
+    moveCoord = coord;
+    return true;
+}
+
+bool GameCore::getMoveCoord(MoveResult::Direction direction,
+                            CoreCoord::Coord &moveCoord) const
+{
+    if(direction == MoveResult::Direction::None)
+        return false;
+
+    auto index = m_moveTable->getNeighbor(m_emptyIndex, static_cast<int>(direction));
+    if(index == MoveTable::kNoNeighbor)
+        return false;
+
+    moveCoord = m_moveTable->getCoord(index);
+    return true;
+}
+
+GameCore::MoveSummary GameCore::shiftTiles(const CoreCoord::Coord &coord,
+                                           MoveResult *result)
+{
+    MoveSummary summary;
+
+    //The tiles go toward the empty one, a step at a time -
+    //Along the row (+-1) or along the col (+-width).
+    auto index = m_board.getIndex(coord);
+    auto step  = 0;
+
+    if(coord.y == m_emptyCoord.y)
+    {
+        step                  = (coord.x < m_emptyCoord.x) ? -1 : 1;
+        summary.moveDirection = (step < 0) ? MoveResult::Direction::Left
+                                           : MoveResult::Direction::Right;
+        summary.tilesCount    = (index - m_emptyIndex) * step;
+    }
+    else
+    {
+        step                  = (coord.y < m_emptyCoord.y) ? -getWidth() : getWidth();
+        summary.moveDirection = (step < 0) ? MoveResult::Direction::Up
+                                           : MoveResult::Direction::Down;
+        summary.tilesCount    = (index - m_emptyIndex) / step;
+    }
+
+    //Only the MoveResult path pays for the coords.
+    if(result)
+    {
+        for(auto i = m_emptyIndex; i != index; i += step)
+        {
+            result->previousCoords.push_back(m_moveTable->getCoord(i + step));
+            result->currentCoords.push_back (m_moveTable->getCoord(i));
+        }
+
+        result->moveDirection = summary.moveDirection;
+    }
+
+    switch(m_board.getCellSize())
+    {
+        case 1 : shiftCells<uint8_t >(index, step); break;
+        case 2 : shiftCells<uint16_t>(index, step); break;
+        default: shiftCells<uint32_t>(index, step); break;
+    }
+
+    if(m_trackHeuristics)
+        m_heuristics.update(m_board, m_emptyIndex, index);
+
+    //Only the cells of the segment changed.
+    if(m_hasLegacyBoard)
+    {
+        for(auto i = m_emptyIndex;; i += step)
+        {
+            m_legacyBoard[m_moveTable->getRow(i)][m_moveTable->getCol(i)] =
+                m_board.getValueAt(i);
+
+            if(i == index)
+                break;
+        }
+    }
+
+    m_emptyCoord = coord;
+    m_emptyIndex = index;
+
+    return summary;
+}
+
+GameCore::MoveSummary GameCore::undo(MoveResult *result)
+{
+    if(m_undoIndexes.empty())
+        return MoveSummary();
+
+    auto index = m_undoIndexes.back();
+    m_undoIndexes.pop_back();
+    m_redoIndexes.push_back(m_emptyIndex);
+
+    auto summary = shiftTiles(m_moveTable->getCoord(index), result);
+
+    if(m_moveLog)
+        m_moveLog->recordUndo();
+
+    COREPUZZLE15_TRACE(onUndo(*this, summary));
+
+    //Moves only happen while the game continues.
+    --m_movesCount;
+    setStatus(CoreGame::Status::Continue);
+
+    return summary;
+}
+
+GameCore::MoveSummary GameCore::redo(MoveResult *result)
+{
+    if(m_redoIndexes.empty())
+        return MoveSummary();
+
+    auto index = m_redoIndexes.back();
+    m_redoIndexes.pop_back();
+    m_undoIndexes.push_back(m_emptyIndex);
+
+    auto summary = shiftTiles(m_moveTable->getCoord(index), result);
+
+    if(m_moveLog)
+        m_moveLog->recordRedo();
+
+    COREPUZZLE15_TRACE(onRedo(*this, summary));
+
+    ++m_movesCount;
+    checkStatus();
+
+    return summary;
+}
+
+void GameCore::resetState(int maxMoves, int seed)
+{
+    setStatus(CoreGame::Status::Continue);
+    m_movesCount      = 0;
+    m_maxMovesCount   = maxMoves;
+    m_trackHeuristics = false;
+    m_hasLegacyBoard  = false;
+    m_moveLog         = nullptr;
+    m_random          = CoreRandom::Random(seed);
+
+    clearHistory();
+}
+
+void GameCore::initBoard(int width, int height, const FlatBoard *givenBoard)
+{
+    m_board.resize(width, height);
+
+    //Only a new size looks for it's table.
+    if(!m_moveTable                      ||
+       m_moveTable->getWidth () != width ||
+       m_moveTable->getHeight() != height)
+    {
+        m_moveTable = &MoveTable::get(width, height);
+    }
+
+    //Shuffle the values in place - The generator
+    //only makes Boards that can be solved.
+    auto &rng = m_random.getNumberGenerator();
+    switch(m_boardSource)
+    {
+        case BoardSource::Difficulty:
+            BoardGenerator::generate(m_board, m_difficulty, rng);
+            break;
+
+        case BoardSource::Series:
+            BoardGenerator::generateSeries(m_board, m_series);
+            break;
+
+        case BoardSource::Given:
+            for(int i = 0; i < m_board.getCellsCount(); ++i)
+                m_board.setValueAt(i, givenBoard->getValueAt(i));
+            break;
+
+        default:
+            BoardGenerator::generate(m_board, rng);
+            break;
+    }
+
+    //Find the kEmptyValue...
+    //i.e that coord will contain the kEmptyValue at start.
+    for(int i = 0; i < m_board.getCellsCount(); ++i)
+    {
+        if(m_board.getValueAt(i) == kEmptyValue)
+        {
+            m_emptyCoord = m_board.getCoord(i);
+            m_emptyIndex = i;
+            break;
+        }
+    }
+
+    countCorrectTiles();
+    m_hash = Zobrist::hash(m_board);
+
+    if(m_trackHeuristics)
+        m_heuristics.reset(m_board);
+
+    COREPUZZLE15_TRACE(onBoardGenerated(*this));
 }
 
 void GameCore::checkStatus()
 {
+    COREPUZZLE15_METRICS_TIME(CheckStatusNanoseconds);
+
     //Player sort all values - Game Won
     if(valuesAreSorted())
     {
-        m_status = CoreGame::Status::Victory;
+        setStatus(CoreGame::Status::Victory);
         return;
     }
 
@@ -257,42 +880,72 @@ void GameCore::checkStatus()
     //reach the max moves allowed.
     if(getRemainingMovesCount() == 0)
     {
-        m_status = CoreGame::Status::Defeat;
+        setStatus(CoreGame::Status::Defeat);
     }
 }
 
-bool GameCore::valuesAreSorted()
+void GameCore::setStatus(CoreGame::Status status)
 {
-    //
-    if(m_board[getHeight() -1][getWidth() -1] ==  kEmptyValue)
-        return false;
+    if(status == m_status)
+        return;
+
+    auto oldStatus = m_status;
+    m_status       = status;
+
+    COREPUZZLE15_TRACE(onStatusChanged(*this, oldStatus));
+    (void)oldStatus; //Unused when trace is disabled.
+}
+
+bool GameCore::valuesAreSorted() const
+{
+    //All tiles are in place - So the last
+    //cell is the only one left for the kEmptyValue.
+    return m_correctTilesCount == m_board.getCellsCount() -1;
+}
+
+void GameCore::countCorrectTiles()
+{
+    m_correctTilesCount = BoardKernels::countCorrectTiles(m_board);
+}
 
-    //Check if all values are sorted.
-    int prevValue = -1;
-    int sorted    = true;
+//Moves the tiles from the empty index (exclusive) to index
+//one step back and puts the empty tile at index.
+template <typename T>
+void GameCore::shiftCells(int index, int step)
+{
+    auto cells = m_board.getCells<T>();
 
-    for(int i = 0; i < getHeight(); ++i)
+    //Each tile changes it's key and maybe it's in place state.
+    for(auto i = m_emptyIndex + step;; i += step)
     {
-        for(int j = 0; j < getWidth(); ++j)
-        {
-            //Last value must be the kEmptyValue.
-            if(i == getHeight() -1 && j == getWidth() -1)
-                return true;
+        auto value = static_cast<int>(cells[i]);
 
-            int value = m_board[i][j];
-            if(prevValue > value)
-                return false;
+        m_hash ^= Zobrist::getKey(value, i) ^ Zobrist::getKey(value, i - step);
+        m_correctTilesCount += (value == i - step + 1) - (value == i + 1);
 
-            prevValue = value;
-        }
+        if(i == index)
+            break;
     }
 
-    return true;
-}
+    m_hash ^= Zobrist::getKey(kEmptyValue, m_emptyIndex)
+            ^ Zobrist::getKey(kEmptyValue, index);
 
-void GameCore::swapValuesAt(const CoreCoord::Coord &coord1,
-                            const CoreCoord::Coord &coord2)
-{
-    std::swap(m_board[coord1.y][coord1.x],
-              m_board[coord2.y][coord2.x]);
+    //A row segment is contiguous - A col one is strided.
+    if(step == 1)
+    {
+        std::memmove(cells + m_emptyIndex, cells + m_emptyIndex + 1,
+                     (index - m_emptyIndex) * sizeof(T));
+    }
+    else if(step == -1)
+    {
+        std::memmove(cells + index + 1, cells + index,
+                     (m_emptyIndex - index) * sizeof(T));
+    }
+    else
+    {
+        for(auto i = m_emptyIndex; i != index; i += step)
+            cells[i] = cells[i + step];
+    }
+
+    cells[index] = static_cast<T>(kEmptyValue);
 }
@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        GameCorePool.cpp                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/GameCorePool.h"
+//std
+#include <vector>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const size_t GameCorePool::kDefaultMaxFreeCount;
+
+namespace {
+
+struct Arena
+{
+    Arena() :
+        maxFreeCount(GameCorePool::kDefaultMaxFreeCount)
+    {
+        //Empty...
+    }
+
+    ~Arena()
+    {
+        for(auto core : cores)
+            delete core;
+    }
+
+    std::vector<GameCore *> cores;
+    size_t                  maxFreeCount;
+};
+
+Arena& getArena()
+{
+    static thread_local Arena s_arena;
+    return s_arena;
+}
+
+//Takes a free GameCore or nullptr.
+GameCore* take()
+{
+    auto &arena = getArena();
+    if(arena.cores.empty())
+        return nullptr;
+
+    auto core = arena.cores.back();
+    arena.cores.pop_back();
+
+    return core;
+}
+
+} //namespace
+
+
+// Inner Types //
+void GameCorePool::Deleter::operator()(GameCore *core) const
+{
+    GameCorePool::release(core);
+}
+
+
+// Public Methods //
+GameCorePool::Pointer GameCorePool::acquire(int width, int height,
+                                            int maxMoves, int seed)
+{
+    auto core = take();
+    if(core)
+        core->reset(width, height, maxMoves, seed);
+    else
+        core = new GameCore(width, height, maxMoves, seed);
+
+    return Pointer(core);
+}
+
+GameCorePool::Pointer GameCorePool::acquire(int width, int height,
+                                            const BoardGenerator::Difficulty &difficulty,
+                                            int maxMoves, int seed)
+{
+    auto core = take();
+    if(core)
+        core->reset(width, height, difficulty, maxMoves, seed);
+    else
+        core = new GameCore(width, height, difficulty, maxMoves, seed);
+
+    return Pointer(core);
+}
+
+void GameCorePool::release(GameCore *core)
+{
+    if(!core)
+        return;
+
+    auto &arena = getArena();
+    if(arena.cores.size() >= arena.maxFreeCount)
+    {
+        delete core;
+        return;
+    }
+
+    //Don't keep the log of the last game.
+    core->setMoveLog(nullptr);
+    arena.cores.push_back(core);
+}
+
+
+void GameCorePool::reserve(size_t count, int width, int height)
+{
+    auto &arena = getArena();
+    arena.cores.reserve(arena.maxFreeCount);
+
+    while(arena.cores.size() < count && arena.cores.size() < arena.maxFreeCount)
+        arena.cores.push_back(new GameCore(width, height));
+}
+
+void GameCorePool::clear()
+{
+    auto &arena = getArena();
+    for(auto core : arena.cores)
+        delete core;
+
+    arena.cores.clear();
+}
+
+size_t GameCorePool::getFreeCount()
+{
+    return getArena().cores.size();
+}
+
+void GameCorePool::setMaxFreeCount(size_t maxFreeCount)
+{
+    auto &arena = getArena();
+    arena.maxFreeCount = maxFreeCount;
+
+    while(arena.cores.size() > maxFreeCount)
+    {
+        delete arena.cores.back();
+        arena.cores.pop_back();
+    }
+}
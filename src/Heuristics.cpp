@@ -0,0 +1,166 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Heuristics.cpp                            //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/Heuristics.h"
+//std
+#include <algorithm>
+#include <vector>
+//CorePuzzle15
+#include "../include/BoardKernels.h"
+#include "../include/WalkingDistance.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Public Methods //
+int Heuristics::manhattanDistance(const FlatBoard &board)
+{
+    return BoardKernels::manhattanDistance(board);
+}
+
+int Heuristics::linearConflict(const FlatBoard &board)
+{
+    auto width  = board.getWidth();
+    auto height = board.getHeight();
+
+    std::vector<int> goals(std::max(width, height));
+    int conflict = 0;
+
+    for(int i = 0; i < height; ++i)
+        conflict += rowConflict(board, i, goals.data());
+
+    for(int j = 0; j < width; ++j)
+        conflict += colConflict(board, j, goals.data());
+
+    return conflict;
+}
+
+int Heuristics::rowConflict(const FlatBoard &board, int row, int *goals)
+{
+    auto width = board.getWidth();
+    auto count = board.getCellsCount();
+
+    int goalsCount = 0;
+    for(int j = 0; j < width; ++j)
+    {
+        auto value = board.getValueAt(row * width + j);
+        auto goal  = getGoalIndex(value, count);
+
+        if(value != 0 && goal / width == row)
+            goals[goalsCount++] = goal % width;
+    }
+
+    return lineConflict(goals, goalsCount);
+}
+
+int Heuristics::colConflict(const FlatBoard &board, int col, int *goals)
+{
+    auto width  = board.getWidth();
+    auto height = board.getHeight();
+    auto count  = board.getCellsCount();
+
+    int goalsCount = 0;
+    for(int i = 0; i < height; ++i)
+    {
+        auto value = board.getValueAt(i * width + col);
+        auto goal  = getGoalIndex(value, count);
+
+        if(value != 0 && goal % width == col)
+            goals[goalsCount++] = goal / width;
+    }
+
+    return lineConflict(goals, goalsCount);
+}
+
+int Heuristics::lineConflict(int *goals, int count)
+{
+    //The tiles that stay are the longest increasing subsequence
+    //of goals, all the others must leave the line and come back.
+    //Patience sorting - goals[k] becomes the smallest tail of the
+    //increasing subsequences of length k + 1 found so far. It never
+    //writes past the goal being read, so it can be done in place.
+    int longest = 0;
+
+    for(int i = 0; i < count; ++i)
+    {
+        auto goal = goals[i];
+        auto it   = std::lower_bound(goals, goals + longest, goal);
+        *it = goal;
+
+        if(it == goals + longest)
+            ++longest;
+    }
+
+    return 2 * (count - longest);
+}
+
+int Heuristics::walkingDistance(const FlatBoard &board)
+{
+    auto rows = WalkingDistance::get(board, WalkingDistance::Lines::Rows   );
+    auto cols = WalkingDistance::get(board, WalkingDistance::Lines::Columns);
+    if(!rows || !cols)
+        return -1;
+
+    auto rowsDistance = rows->getDistance(
+        rows->getKey(board, WalkingDistance::Lines::Rows)
+    );
+    auto colsDistance = cols->getDistance(
+        cols->getKey(board, WalkingDistance::Lines::Columns)
+    );
+    if(rowsDistance < 0 || colsDistance < 0)
+        return -1;
+
+    return rowsDistance + colsDistance;
+}
+
+int Heuristics::evaluate(const FlatBoard &board, Kind kind)
+{
+    switch(kind)
+    {
+        case Kind::Manhattan      : return manhattanDistance(board);
+        case Kind::LinearConflict : return manhattanDistance(board)
+                                         + linearConflict   (board);
+        case Kind::WalkingDistance: return walkingDistance  (board);
+    }
+
+    return -1;
+}
@@ -0,0 +1,188 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        HeuristicsTracker.cpp                     //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/HeuristicsTracker.h"
+//std
+#include <algorithm>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// CTOR/DTOR //
+HeuristicsTracker::HeuristicsTracker() :
+    m_width     (0),
+    m_cellsCount(0),
+    m_manhattan (0),
+    m_conflict  (0),
+    m_rowsTable (nullptr),
+    m_colsTable (nullptr),
+    m_rowsKey   (0),
+    m_colsKey   (0)
+{
+    //Empty...
+}
+
+
+// Public Methods //
+void HeuristicsTracker::reset(const FlatBoard &board)
+{
+    auto width  = board.getWidth ();
+    auto height = board.getHeight();
+
+    m_width      = width;
+    m_cellsCount = board.getCellsCount();
+    m_manhattan  = Heuristics::manhattanDistance(board);
+
+    //Conflicts by line, so a slide only redoes the lines it touched.
+    m_rowConflicts.resize(height);
+    m_colConflicts.resize(width);
+    m_goals.resize(std::max(width, height));
+
+    m_conflict = 0;
+    for(int i = 0; i < height; ++i)
+    {
+        m_rowConflicts[i] = Heuristics::rowConflict(board, i, m_goals.data());
+        m_conflict       += m_rowConflicts[i];
+    }
+    for(int j = 0; j < width; ++j)
+    {
+        m_colConflicts[j] = Heuristics::colConflict(board, j, m_goals.data());
+        m_conflict       += m_colConflicts[j];
+    }
+
+    m_rowsTable = WalkingDistance::get(board, WalkingDistance::Lines::Rows   );
+    m_colsTable = WalkingDistance::get(board, WalkingDistance::Lines::Columns);
+    if(!m_rowsTable || !m_colsTable)
+    {
+        m_rowsTable = nullptr;
+        m_colsTable = nullptr;
+        return;
+    }
+
+    m_rowsKey = m_rowsTable->getKey(board, WalkingDistance::Lines::Rows   );
+    m_colsKey = m_colsTable->getKey(board, WalkingDistance::Lines::Columns);
+}
+
+void HeuristicsTracker::update(const FlatBoard &board,
+                               int oldEmptyIndex, int newEmptyIndex)
+{
+    auto width      = m_width;
+    auto horizontal = (oldEmptyIndex / width == newEmptyIndex / width);
+
+    //Each tile went one step toward the old empty index.
+    auto step = horizontal ? 1 : width;
+    if(oldEmptyIndex < newEmptyIndex)
+        step = -step;
+
+    //The order inside of the line of the slide is the same - Only the
+    //lines across it have other tiles. Tiles changed between them.
+    auto getLine = [width, horizontal](int index) {
+        return horizontal ? index % width : index / width;
+    };
+
+    auto &conflicts = horizontal ? m_colConflicts : m_rowConflicts;
+    auto  table     = horizontal ? m_colsTable    : m_rowsTable;
+    auto &key       = horizontal ? m_colsKey      : m_rowsKey;
+
+    for(auto index = oldEmptyIndex; index != newEmptyIndex; index -= step)
+    {
+        auto value = board.getValueAt(index);
+        auto from  = index - step;
+
+        m_manhattan += Heuristics::getTileDistance(value, index, width, m_cellsCount)
+                     - Heuristics::getTileDistance(value, from,  width, m_cellsCount);
+
+        auto goalLine = getLine(value - 1);
+        auto fromLine = getLine(from );
+        auto toLine   = getLine(index);
+
+        if(table)
+        {
+            key += table->getWeight(toLine,   goalLine)
+                 - table->getWeight(fromLine, goalLine);
+        }
+
+        //The conflicts of a line only count the tiles of that line,
+        //so the others can come and go for free.
+        if(goalLine != fromLine && goalLine != toLine)
+            continue;
+
+        m_conflict -= conflicts[goalLine];
+        conflicts[goalLine] = horizontal
+            ? Heuristics::colConflict(board, goalLine, m_goals.data())
+            : Heuristics::rowConflict(board, goalLine, m_goals.data());
+        m_conflict += conflicts[goalLine];
+    }
+
+    if(table)
+    {
+        key += getLine(newEmptyIndex) * table->getEmptyWeight()
+             - getLine(oldEmptyIndex) * table->getEmptyWeight();
+    }
+}
+
+int HeuristicsTracker::get(Heuristics::Kind kind) const
+{
+    switch(kind)
+    {
+        case Heuristics::Kind::Manhattan:
+            return m_manhattan;
+
+        case Heuristics::Kind::LinearConflict:
+            return m_manhattan + m_conflict;
+
+        case Heuristics::Kind::WalkingDistance:
+        {
+            if(!m_rowsTable)
+                return -1;
+
+            auto rowsDistance = m_rowsTable->getDistance(m_rowsKey);
+            auto colsDistance = m_colsTable->getDistance(m_colsKey);
+            if(rowsDistance < 0 || colsDistance < 0)
+                return -1;
+
+            return rowsDistance + colsDistance;
+        }
+    }
+
+    return -1;
+}
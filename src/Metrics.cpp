@@ -0,0 +1,329 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Metrics.cpp                               //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/Metrics.h"
+//std
+#include <atomic>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int Metrics::kCountersCount;
+const int Metrics::kHistogramsCount;
+const int Metrics::kBucketsCount;
+
+namespace {
+
+//Storage of one thread - Only that thread writes on it.
+struct ThreadStorage
+{
+    ThreadStorage();
+    ~ThreadStorage();
+
+    void addTo(Metrics::Snapshot &snapshot) const;
+
+    std::atomic<uint64_t> counters[Metrics::kCountersCount];
+    std::atomic<uint64_t> buckets [Metrics::kHistogramsCount][Metrics::kBucketsCount];
+    std::atomic<uint64_t> sums    [Metrics::kHistogramsCount];
+};
+
+struct Registry
+{
+    Registry() :
+        retired (),
+        baseline()
+    {
+        //Empty...
+    }
+
+    std::mutex                   mutex;
+    std::vector<ThreadStorage *> storages;
+
+    Metrics::Snapshot retired;  //Totals of the threads that exited.
+    Metrics::Snapshot baseline; //Totals at the last reset().
+};
+
+Registry& getRegistry()
+{
+    static Registry s_registry;
+    return s_registry;
+}
+
+ThreadStorage& getThreadStorage()
+{
+    static thread_local ThreadStorage s_storage;
+    return s_storage;
+}
+
+//Single writer - A plain load and store is enough and
+//avoids the locked add.
+inline void increment(std::atomic<uint64_t> &value, uint64_t amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+ThreadStorage::ThreadStorage()
+{
+    for(auto &counter : counters)
+        counter.store(0, std::memory_order_relaxed);
+
+    for(int i = 0; i < Metrics::kHistogramsCount; ++i)
+    {
+        for(auto &bucket : buckets[i])
+            bucket.store(0, std::memory_order_relaxed);
+
+        sums[i].store(0, std::memory_order_relaxed);
+    }
+
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.storages.push_back(this);
+}
+
+ThreadStorage::~ThreadStorage()
+{
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    addTo(registry.retired);
+    for(size_t i = 0; i < registry.storages.size(); ++i)
+    {
+        if(registry.storages[i] != this)
+            continue;
+
+        registry.storages[i] = registry.storages.back();
+        registry.storages.pop_back();
+        break;
+    }
+}
+
+void ThreadStorage::addTo(Metrics::Snapshot &snapshot) const
+{
+    for(int i = 0; i < Metrics::kCountersCount; ++i)
+        snapshot.counters[i] += counters[i].load(std::memory_order_relaxed);
+
+    for(int i = 0; i < Metrics::kHistogramsCount; ++i)
+    {
+        auto &histogram = snapshot.histograms[i];
+        for(int j = 0; j < Metrics::kBucketsCount; ++j)
+            histogram.buckets[j] += buckets[i][j].load(std::memory_order_relaxed);
+
+        histogram.sum += sums[i].load(std::memory_order_relaxed);
+    }
+}
+
+void subtract(Metrics::Snapshot &snapshot, const Metrics::Snapshot &other)
+{
+    for(int i = 0; i < Metrics::kCountersCount; ++i)
+        snapshot.counters[i] -= other.counters[i];
+
+    for(int i = 0; i < Metrics::kHistogramsCount; ++i)
+    {
+        for(int j = 0; j < Metrics::kBucketsCount; ++j)
+            snapshot.histograms[i].buckets[j] -= other.histograms[i].buckets[j];
+
+        snapshot.histograms[i].sum -= other.histograms[i].sum;
+    }
+}
+
+//Totals of all threads, reset() ignored.
+Metrics::Snapshot getTotals(Registry &registry)
+{
+    auto totals = registry.retired;
+    for(auto storage : registry.storages)
+        storage->addTo(totals);
+
+    return totals;
+}
+
+std::string toString(double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+void appendHeader(std::string &str, const std::string &name,
+                  const char *type, const char *help)
+{
+    str += "# HELP " + name + " " + help + "\n";
+    str += "# TYPE " + name + " " + type + "\n";
+}
+
+void appendSample(std::string &str, const std::string &name,
+                  const std::string &labels, const std::string &value)
+{
+    str += name + labels + " " + value + "\n";
+}
+
+//Buckets are cumulative in Prometheus and scale converts the
+//bounds and the sum to the exported unit.
+void appendHistogram(std::string &str, const std::string &name,
+                     const char *help,
+                     const Metrics::HistogramSnapshot &histogram,
+                     double scale)
+{
+    appendHeader(str, name, "histogram", help);
+
+    uint64_t count = 0;
+    for(int i = 0; i < Metrics::kBucketsCount; ++i)
+    {
+        count += histogram.buckets[i];
+
+        auto bound = (i == Metrics::kBucketsCount - 1)
+                     ? std::string("+Inf")
+                     : toString(Metrics::getBucketBound(i) * scale);
+
+        appendSample(str, name + "_bucket", "{le=\"" + bound + "\"}",
+                     std::to_string(count));
+    }
+
+    appendSample(str, name + "_sum",   "", toString(histogram.sum * scale));
+    appendSample(str, name + "_count", "", std::to_string(count));
+}
+
+} //namespace
+
+
+// Inner Types //
+uint64_t Metrics::HistogramSnapshot::getCount() const
+{
+    uint64_t count = 0;
+    for(auto bucket : buckets)
+        count += bucket;
+
+    return count;
+}
+
+
+// Public Methods //
+void Metrics::add(Counter counter, uint64_t value)
+{
+    auto &storage = getThreadStorage();
+    increment(storage.counters[static_cast<int>(counter)], value);
+}
+
+void Metrics::observe(Histogram histogram, uint64_t value)
+{
+    auto &storage = getThreadStorage();
+    auto  index   = static_cast<int>(histogram);
+
+    increment(storage.buckets[index][getBucketIndex(value)], 1);
+    increment(storage.sums   [index],                       value);
+}
+
+
+Metrics::Snapshot Metrics::snapshot()
+{
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto totals = getTotals(registry);
+    subtract(totals, registry.baseline);
+
+    return totals;
+}
+
+std::string Metrics::prometheus(const std::string &prefix)
+{
+    auto values = snapshot();
+    auto str    = std::string();
+
+    auto movesName = prefix + "_moves_total";
+    appendHeader(str, movesName, "counter", "Moves that shifted tiles.");
+    appendSample(str, movesName, "",
+                 std::to_string(values.getCounter(Counter::MovesCount)));
+
+    auto rejectedName = prefix + "_rejected_moves_total";
+    appendHeader(str, rejectedName, "counter", "Moves that did nothing, by reason.");
+    appendSample(str, rejectedName, "{reason=\"game_over\"}",
+                 std::to_string(values.getCounter(Counter::RejectedGameOverCount)));
+    appendSample(str, rejectedName, "{reason=\"empty_coord\"}",
+                 std::to_string(values.getCounter(Counter::RejectedEmptyCoordCount)));
+    appendSample(str, rejectedName, "{reason=\"not_in_line\"}",
+                 std::to_string(values.getCounter(Counter::RejectedNotInLineCount)));
+
+    appendHistogram(str, prefix + "_tiles_shifted",
+                    "Tiles shifted by each move.",
+                    values.getHistogram(Histogram::TilesShifted),
+                    1);
+
+    appendHistogram(str, prefix + "_check_status_seconds",
+                    "Time spent checking the game status.",
+                    values.getHistogram(Histogram::CheckStatusNanoseconds),
+                    1e-9);
+
+    return str;
+}
+
+void Metrics::reset()
+{
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.baseline = getTotals(registry);
+}
+
+
+int Metrics::getBucketIndex(uint64_t value)
+{
+    if(value <= 1)
+        return 0;
+
+    //ceil(log2(value))
+    int index = 64 - __builtin_clzll(value - 1);
+    return (index < kBucketsCount) ? index : kBucketsCount - 1;
+}
+
+uint64_t Metrics::getBucketBound(int index)
+{
+    if(index >= kBucketsCount - 1)
+        return std::numeric_limits<uint64_t>::max();
+
+    return uint64_t(1) << index;
+}
@@ -0,0 +1,250 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MoveLog.cpp                               //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/MoveLog.h"
+//std
+#include <fstream>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int     MoveLog::kMaxRunLength;
+const uint8_t MoveLog::kVersion;
+const uint8_t MoveLog::kUndoCode;
+const uint8_t MoveLog::kRedoCode;
+const uint8_t MoveLog::kSeedBoard;
+const uint8_t MoveLog::kDifficultyBoard;
+const uint8_t MoveLog::kSeriesBoard;
+const char    MoveLog::kMagic[7] = { 'C', 'P', '1', '5', 'L', 'O', 'G' };
+
+namespace {
+
+uint64_t zigzag(int value)
+{
+    auto v = static_cast<int64_t>(value);
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+MoveLog::MoveLog() :
+    m_runLength (0),
+    m_movesCount(0)
+{
+    //Empty...
+}
+
+
+// Public Methods //
+void MoveLog::begin(const FlatBoard &board, int seed, int maxMoves)
+{
+    writeHeader(board.getWidth(), board.getHeight(), seed, maxMoves,
+                kSeedBoard);
+
+    writeCells(board);
+}
+
+void MoveLog::begin(const FlatBoard &board,
+                    const BoardGenerator::Difficulty &difficulty,
+                    int seed, int maxMoves)
+{
+    writeHeader(board.getWidth(), board.getHeight(), seed, maxMoves,
+                kDifficultyBoard);
+
+    writeVarint(m_data, zigzag(difficulty.minDistance));
+    writeVarint(m_data, zigzag(difficulty.maxDistance));
+
+    writeCells(board);
+}
+
+void MoveLog::begin(int width, int height,
+                    const BoardGenerator::Series &series,
+                    int maxMoves)
+{
+    writeHeader(width, height, 0, maxMoves, kSeriesBoard);
+
+    writeVarint(m_data, series.seed );
+    writeVarint(m_data, series.index);
+}
+
+void MoveLog::record(GameCore::MoveResult::Direction direction,
+                     int tilesCount)
+{
+    if(tilesCount < 1 || direction == GameCore::MoveResult::Direction::None)
+        return;
+
+    ++m_movesCount;
+    auto code = static_cast<uint8_t>(direction);
+
+    //Slide of many tiles.
+    if(tilesCount > 1)
+    {
+        recordEscape(code);
+        writeVarint(m_data, static_cast<uint64_t>(tilesCount));
+        return;
+    }
+
+    if(m_runLength % 4 == 0)
+        m_run.push_back(0);
+
+    m_run.back() |= code << ((m_runLength % 4) * 2);
+    ++m_runLength;
+
+    if(m_runLength == kMaxRunLength)
+        flush();
+}
+
+void MoveLog::recordUndo()
+{
+    ++m_movesCount;
+    recordEscape(kUndoCode);
+}
+
+void MoveLog::recordRedo()
+{
+    ++m_movesCount;
+    recordEscape(kRedoCode);
+}
+
+void MoveLog::flush()
+{
+    if(m_runLength == 0)
+        return;
+
+    writeVarint(m_data, static_cast<uint64_t>(m_runLength));
+    m_data.insert(m_data.end(), m_run.begin(), m_run.end());
+
+    m_run.clear();
+    m_runLength = 0;
+}
+
+int MoveLog::getMovesCount() const
+{
+    return m_movesCount;
+}
+
+const std::vector<uint8_t>& MoveLog::getData() const
+{
+    return m_data;
+}
+
+bool MoveLog::save(const std::string &path)
+{
+    flush();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(m_data.data()),
+               static_cast<std::streamsize>(m_data.size()));
+
+    return file.good();
+}
+
+
+// Static Methods //
+void MoveLog::writeVarint(std::vector<uint8_t> &data, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+bool MoveLog::readVarint(const uint8_t *data, size_t size,
+                         size_t &offset, uint64_t &value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        if(offset >= size)
+            return false;
+
+        auto byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if((byte & 0x80) == 0)
+            return true;
+    }
+
+    //Too long to be a varint.
+    return false;
+}
+
+
+// Private Methods //
+void MoveLog::writeHeader(int width, int height, int seed, int maxMoves,
+                          uint8_t boardCode)
+{
+    m_data.clear();
+    m_run.clear();
+    m_runLength  = 0;
+    m_movesCount = 0;
+
+    for(auto c : kMagic)
+        m_data.push_back(static_cast<uint8_t>(c));
+    m_data.push_back(kVersion);
+
+    writeVarint(m_data, static_cast<uint64_t>(width ));
+    writeVarint(m_data, static_cast<uint64_t>(height));
+    writeVarint(m_data, zigzag(seed    ));
+    writeVarint(m_data, zigzag(maxMoves));
+    writeVarint(m_data, boardCode);
+}
+
+void MoveLog::writeCells(const FlatBoard &board)
+{
+    for(int i = 0; i < board.getCellsCount(); ++i)
+        writeVarint(m_data, static_cast<uint64_t>(board.getValueAt(i)));
+}
+
+void MoveLog::recordEscape(uint8_t code)
+{
+    //The pending run must go first to keep the order.
+    flush();
+
+    writeVarint(m_data, 0);
+    m_data.push_back(code);
+}
@@ -0,0 +1,476 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MoveLogReader.cpp                         //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/MoveLogReader.h"
+//std
+#include <cstring>
+#include <vector>
+//POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+namespace {
+
+int unzigzag(uint64_t value)
+{
+    return static_cast<int>(static_cast<int64_t>(value >> 1) ^
+                            -static_cast<int64_t>(value & 1));
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+MoveLogReader::MoveLogReader() :
+    m_mapping      (nullptr),
+    m_mappingSize  (0),
+    m_data         (nullptr),
+    m_size         (0),
+    m_movesOffset  (0),
+    m_offset       (0),
+    m_error        (false),
+    m_width        (0),
+    m_height       (0),
+    m_seed         (0),
+    m_maxMoves     (0),
+    m_boardCode    (MoveLog::kSeedBoard),
+    m_cellsOffset  (0),
+    m_difficulty   (0, 0),
+    m_series       (0, 0),
+    m_runOffset    (0),
+    m_runLength    (0),
+    m_runIndex     (0)
+{
+    //Empty...
+}
+
+MoveLogReader::~MoveLogReader()
+{
+    close();
+}
+
+
+// Public Methods //
+bool MoveLogReader::open(const uint8_t *data, size_t size)
+{
+    close();
+
+    m_data = data;
+    m_size = size;
+
+    if(!readHeader())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool MoveLogReader::load(const std::string &path)
+{
+    close();
+
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if(fd == -1)
+        return false;
+
+    struct stat info;
+    if(fstat(fd, &info) == -1 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    auto size    = static_cast<size_t>(info.st_size);
+    auto mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); //The mapping keeps the file alive.
+
+    if(mapping == MAP_FAILED)
+        return false;
+
+    //The moves are read once from the start to the end.
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    if(!open(static_cast<const uint8_t *>(mapping), size))
+    {
+        munmap(mapping, size);
+        return false;
+    }
+
+    m_mapping     = mapping;
+    m_mappingSize = size;
+
+    return true;
+}
+
+void MoveLogReader::close()
+{
+    if(m_mapping)
+        munmap(m_mapping, m_mappingSize);
+
+    m_mapping     = nullptr;
+    m_mappingSize = 0;
+    m_data        = nullptr;
+    m_size        = 0;
+    m_movesOffset = 0;
+    m_cellsOffset = 0;
+    m_error       = false;
+
+    rewind();
+}
+
+bool MoveLogReader::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+bool MoveLogReader::hasError() const
+{
+    return m_error;
+}
+
+
+int MoveLogReader::getWidth() const
+{
+    return m_width;
+}
+
+int MoveLogReader::getHeight() const
+{
+    return m_height;
+}
+
+int MoveLogReader::getSeed() const
+{
+    return m_seed;
+}
+
+int MoveLogReader::getMaxMoves() const
+{
+    return m_maxMoves;
+}
+
+bool MoveLogReader::hasDifficulty() const
+{
+    return m_boardCode == MoveLog::kDifficultyBoard;
+}
+
+const BoardGenerator::Difficulty& MoveLogReader::getDifficulty() const
+{
+    return m_difficulty;
+}
+
+bool MoveLogReader::hasSeries() const
+{
+    return m_boardCode == MoveLog::kSeriesBoard;
+}
+
+const BoardGenerator::Series& MoveLogReader::getSeries() const
+{
+    return m_series;
+}
+
+bool MoveLogReader::hasBoard() const
+{
+    return m_cellsOffset != 0;
+}
+
+void MoveLogReader::getBoard(FlatBoard &board) const
+{
+    board.resize(m_width, m_height);
+
+    //Checked by readHeader().
+    auto offset = m_cellsOffset;
+    for(int i = 0; i < board.getCellsCount(); ++i)
+    {
+        uint64_t value;
+        MoveLog::readVarint(m_data, m_size, offset, value);
+        board.setValueAt(i, static_cast<int>(value));
+    }
+}
+
+void MoveLogReader::initCore(GameCore &core) const
+{
+    if(hasBoard())
+    {
+        FlatBoard board;
+        getBoard(board);
+
+        core.reset(board, m_maxMoves, m_seed);
+    }
+    else if(hasDifficulty())
+        core.reset(m_width, m_height, m_difficulty, m_maxMoves, m_seed);
+    else if(hasSeries())
+        core.reset(m_width, m_height, m_series, m_maxMoves);
+    else
+        core.reset(m_width, m_height, m_maxMoves, m_seed);
+}
+
+
+bool MoveLogReader::next(Entry &entry)
+{
+    if(!m_data || m_error)
+        return false;
+
+    //Inside of a run of single tile moves.
+    if(m_runIndex < m_runLength)
+    {
+        auto byte = m_data[m_runOffset + m_runIndex / 4];
+        auto code = (byte >> ((m_runIndex % 4) * 2)) & 0x03;
+
+        entry.type       = Entry::Type::Move;
+        entry.direction  = static_cast<GameCore::MoveResult::Direction>(code);
+        entry.tilesCount = 1;
+
+        ++m_runIndex;
+        return true;
+    }
+
+    if(m_offset == m_size)
+        return false;
+
+    uint64_t count;
+    if(!MoveLog::readVarint(m_data, m_size, m_offset, count) ||
+       count > static_cast<uint64_t>(MoveLog::kMaxRunLength))
+    {
+        m_error = true;
+        return false;
+    }
+
+    //Escape - Undo, redo or a slide of many tiles.
+    if(count == 0)
+    {
+        if(m_offset == m_size || m_data[m_offset] > MoveLog::kRedoCode)
+        {
+            m_error = true;
+            return false;
+        }
+
+        auto code = m_data[m_offset++];
+        if(code == MoveLog::kUndoCode || code == MoveLog::kRedoCode)
+        {
+            entry.type = (code == MoveLog::kUndoCode) ? Entry::Type::Undo
+                                                      : Entry::Type::Redo;
+            return true;
+        }
+
+        uint64_t tiles;
+        if(!MoveLog::readVarint(m_data, m_size, m_offset, tiles) ||
+           tiles < 2 || tiles > 0xFFFF)
+        {
+            m_error = true;
+            return false;
+        }
+
+        entry.type       = Entry::Type::Move;
+        entry.direction  = static_cast<GameCore::MoveResult::Direction>(code);
+        entry.tilesCount = static_cast<int>(tiles);
+        return true;
+    }
+
+    //A new run.
+    auto bytesCount = (static_cast<size_t>(count) + 3) / 4;
+    if(bytesCount > m_size - m_offset)
+    {
+        m_error = true;
+        return false;
+    }
+
+    m_runOffset = m_offset;
+    m_runLength = static_cast<int>(count);
+    m_runIndex  = 0;
+    m_offset   += bytesCount;
+
+    return next(entry);
+}
+
+void MoveLogReader::rewind()
+{
+    m_offset    = m_movesOffset;
+    m_runOffset = 0;
+    m_runLength = 0;
+    m_runIndex  = 0;
+}
+
+int MoveLogReader::replay(GameCore &core)
+{
+    Entry entry;
+    int   entriesCount = 0;
+
+    auto width  = core.getWidth ();
+    auto height = core.getHeight();
+
+    while(next(entry))
+    {
+        ++entriesCount;
+
+        if(entry.type == Entry::Type::Undo)
+        {
+            core.undo();
+            continue;
+        }
+        if(entry.type == Entry::Type::Redo)
+        {
+            core.redo();
+            continue;
+        }
+
+        auto coord = core.getEmptyValueCoord();
+        switch(entry.direction)
+        {
+            case GameCore::MoveResult::Direction::Up    : coord.y -= entry.tilesCount; break;
+            case GameCore::MoveResult::Direction::Down  : coord.y += entry.tilesCount; break;
+            case GameCore::MoveResult::Direction::Left  : coord.x -= entry.tilesCount; break;
+            case GameCore::MoveResult::Direction::Right : coord.x += entry.tilesCount; break;
+            case GameCore::MoveResult::Direction::None  : break;
+        }
+
+        //Not a log of this game.
+        if(coord.x < 0 || coord.x >= width || coord.y < 0 || coord.y >= height)
+        {
+            m_error = true;
+            return -1;
+        }
+
+        core.moveFast(coord);
+    }
+
+    return (m_error) ? -1 : entriesCount;
+}
+
+
+// Private Methods //
+bool MoveLogReader::readHeader()
+{
+    if(m_size < sizeof(MoveLog::kMagic) + 1 ||
+       std::memcmp(m_data, MoveLog::kMagic, sizeof(MoveLog::kMagic)) != 0)
+    {
+        return false;
+    }
+
+    //Version 1 has no Board code - All of them are kSeedBoard.
+    auto version = m_data[sizeof(MoveLog::kMagic)];
+    if(version < 1 || version > MoveLog::kVersion)
+        return false;
+
+    size_t   offset = sizeof(MoveLog::kMagic) + 1;
+    uint64_t values[4];
+
+    for(auto &value : values)
+    {
+        if(!MoveLog::readVarint(m_data, m_size, offset, value))
+            return false;
+    }
+
+    if(values[0] == 0 || values[0] > 0xFFFF ||
+       values[1] == 0 || values[1] > 0xFFFF)
+    {
+        return false;
+    }
+
+    uint64_t boardCode = MoveLog::kSeedBoard;
+    if(version != 1 && !MoveLog::readVarint(m_data, m_size, offset, boardCode))
+        return false;
+
+    if(boardCode > MoveLog::kSeriesBoard)
+        return false;
+
+    //Both the band and the series take two varints.
+    uint64_t params[2] = { 0, 0 };
+    if(boardCode != MoveLog::kSeedBoard)
+    {
+        for(auto &value : params)
+        {
+            if(!MoveLog::readVarint(m_data, m_size, offset, value))
+                return false;
+        }
+    }
+
+    m_boardCode  = static_cast<uint8_t>(boardCode);
+    m_difficulty = BoardGenerator::Difficulty(0, 0);
+    m_series     = BoardGenerator::Series    (0, 0);
+
+    if(boardCode == MoveLog::kDifficultyBoard)
+        m_difficulty = BoardGenerator::Difficulty(unzigzag(params[0]), unzigzag(params[1]));
+    else if(boardCode == MoveLog::kSeriesBoard)
+        m_series = BoardGenerator::Series(params[0], params[1]);
+
+    m_width    = static_cast<int>(values[0]);
+    m_height   = static_cast<int>(values[1]);
+    m_seed     = unzigzag(values[2]);
+    m_maxMoves = unzigzag(values[3]);
+
+    //The starting cells - Each value once.
+    m_cellsOffset = 0;
+    if(version >= 3 && boardCode != MoveLog::kSeriesBoard)
+    {
+        auto count = static_cast<uint64_t>(m_width) * m_height;
+        if(count > m_size - offset) //A byte at least each.
+            return false;
+
+        m_cellsOffset = offset;
+
+        std::vector<bool> seen(static_cast<size_t>(count), false);
+        for(uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t value;
+            if(!MoveLog::readVarint(m_data, m_size, offset, value) ||
+               value >= count || seen[value])
+            {
+                return false;
+            }
+            seen[value] = true;
+        }
+    }
+
+    m_movesOffset = offset;
+    rewind();
+
+    return true;
+}
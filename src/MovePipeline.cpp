@@ -0,0 +1,370 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MovePipeline.cpp                          //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/MovePipeline.h"
+//std
+#include <algorithm>
+#include <cstdlib>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const MovePipeline::BoardId MovePipeline::kInvalidBoardId;
+
+namespace {
+
+size_t roundUpToPowerOf2(size_t value)
+{
+    size_t power = 1;
+    while(power < value)
+        power <<= 1;
+
+    return power;
+}
+
+//Same as GameCore does for a move of the tile at
+//coord when the empty tile is at emptyCoord.
+GameCore::MoveSummary makeSummary(const CoreCoord::Coord &emptyCoord,
+                                  const CoreCoord::Coord &coord)
+{
+    GameCore::MoveSummary summary;
+    typedef GameCore::MoveResult::Direction Direction;
+
+         if(coord.x < emptyCoord.x) summary.moveDirection = Direction::Left;
+    else if(coord.x > emptyCoord.x) summary.moveDirection = Direction::Right;
+    else if(coord.y < emptyCoord.y) summary.moveDirection = Direction::Up;
+    else                            summary.moveDirection = Direction::Down;
+
+    summary.tilesCount = std::abs(coord.x - emptyCoord.x) +
+                         std::abs(coord.y - emptyCoord.y);
+
+    return summary;
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+MovePipeline::MovePipeline(const Options &options) :
+    m_options     (options),
+    m_threadsCount(options.threadsCount),
+    m_quit        (false)
+{
+    if(m_threadsCount <= 0)
+        m_threadsCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_options.maxBoardsCount = std::max(1, m_options.maxBoardsCount);
+    m_options.maxBatchSize   = std::max(1, m_options.maxBatchSize);
+    m_options.queueCapacity  = static_cast<int>(roundUpToPowerOf2(
+        static_cast<size_t>(std::max(1, m_options.queueCapacity))
+    ));
+
+    m_queueMask = static_cast<size_t>(m_options.queueCapacity) - 1;
+
+    m_channels.reset(new Channel[m_options.maxBoardsCount]);
+    for(int i = 0; i < m_options.maxBoardsCount; ++i)
+    {
+        auto &channel = m_channels[i];
+        channel.core     .store(nullptr);
+        channel.head     .store(0);
+        channel.tail     .store(0);
+        channel.scheduled.store(false);
+    }
+
+    //Taken from the back - The first ids go first.
+    m_freeBoards.reserve(m_options.maxBoardsCount);
+    for(auto i = m_options.maxBoardsCount; i > 0; --i)
+        m_freeBoards.push_back(i - 1);
+
+    m_coords  .resize(m_threadsCount);
+    m_outcomes.resize(m_threadsCount);
+
+    m_workers.reset(new Worker[m_threadsCount]);
+    for(int i = 0; i < m_threadsCount; ++i)
+        m_workers[i].thread = std::thread(&MovePipeline::workerLoop, this, i);
+}
+
+MovePipeline::~MovePipeline()
+{
+    m_quit.store(true);
+    for(int i = 0; i < m_threadsCount; ++i)
+    {
+        auto &worker = m_workers[i];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+        }
+        worker.condition.notify_one();
+    }
+
+    for(int i = 0; i < m_threadsCount; ++i)
+        m_workers[i].thread.join();
+}
+
+
+// Public Methods //
+MovePipeline::BoardId MovePipeline::attach(GameCore &core)
+{
+    BoardId board;
+    {
+        std::lock_guard<std::mutex> lock(m_boardsMutex);
+        if(m_freeBoards.empty())
+            return kInvalidBoardId;
+
+        board = m_freeBoards.back();
+        m_freeBoards.pop_back();
+    }
+
+    //The ring is made the first time that the id is used.
+    auto &channel = m_channels[board];
+    if(channel.requests.empty())
+        channel.requests.resize(m_options.queueCapacity);
+
+    channel.core.store(&core, std::memory_order_release);
+    return board;
+}
+
+void MovePipeline::detach(BoardId board)
+{
+    auto channel = getChannel(board);
+    if(!channel)
+        return;
+
+    flush(board);
+    channel->core.store(nullptr, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(m_boardsMutex);
+    m_freeBoards.push_back(board);
+}
+
+void MovePipeline::flush(BoardId board)
+{
+    auto channel = getChannel(board);
+    if(!channel)
+        return;
+
+    auto tail = channel->tail.load(std::memory_order_relaxed);
+    while(channel->head.load(std::memory_order_acquire) != tail)
+        std::this_thread::yield();
+}
+
+
+bool MovePipeline::move(BoardId board,
+                        const CoreCoord::Coord &coord,
+                        const Callback &callback)
+{
+    auto channel = getChannel(board);
+    if(!channel)
+        return false;
+
+    auto tail = channel->tail.load(std::memory_order_relaxed);
+    auto head = channel->head.load(std::memory_order_acquire);
+    if(tail - head > m_queueMask)
+        return false;
+
+    auto &request = channel->requests[tail & m_queueMask];
+    request.coord    = coord;
+    request.callback = callback;
+
+    channel->tail.store(tail + 1, std::memory_order_seq_cst);
+
+    //Only the move that finds the Board idle wakes a worker.
+    if(!channel->scheduled.exchange(true, std::memory_order_seq_cst))
+        schedule(board);
+
+    return true;
+}
+
+std::future<MovePipeline::Outcome> MovePipeline::move(BoardId board,
+                                                      const CoreCoord::Coord &coord)
+{
+    auto promise = std::make_shared<std::promise<Outcome>>();
+    auto future  = promise->get_future();
+
+    auto queued = move(board, coord, [promise](const Outcome &outcome) {
+        promise->set_value(outcome);
+    });
+
+    if(!queued)
+    {
+        Outcome outcome;
+        outcome.status = getChannel(board) ? Outcome::Status::QueueFull
+                                           : Outcome::Status::NoBoard;
+        promise->set_value(outcome);
+    }
+
+    return future;
+}
+
+
+int MovePipeline::getThreadsCount() const
+{
+    return m_threadsCount;
+}
+
+const MovePipeline::Options& MovePipeline::getOptions() const
+{
+    return m_options;
+}
+
+
+// Private Methods //
+void MovePipeline::workerLoop(int workerIndex)
+{
+    auto &worker = m_workers[workerIndex];
+
+    for(;;)
+    {
+        BoardId board;
+        {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.condition.wait(lock, [this, &worker]() {
+                return !worker.ready.empty() || m_quit.load();
+            });
+
+            //Nothing left to apply.
+            if(worker.ready.empty())
+                return;
+
+            board = worker.ready.front();
+            worker.ready.pop_front();
+        }
+
+        drain(board, workerIndex);
+    }
+}
+
+void MovePipeline::schedule(BoardId board)
+{
+    auto &worker = m_workers[board % m_threadsCount];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.ready.push_back(board);
+    }
+    worker.condition.notify_one();
+}
+
+//Applies one batch of board - If there's more it goes
+//to the back of the ready queue, so Boards take turns.
+void MovePipeline::drain(BoardId board, int workerIndex)
+{
+    auto &channel = m_channels[board];
+    auto &coords  = m_coords  [workerIndex];
+    auto &results = m_outcomes[workerIndex];
+
+    auto head  = channel.head.load(std::memory_order_relaxed);
+    auto tail  = channel.tail.load(std::memory_order_acquire);
+    auto count = std::min(tail - head,
+                          static_cast<size_t>(m_options.maxBatchSize));
+
+    coords.resize(count);
+    for(size_t i = 0; i < count; ++i)
+        coords[i] = channel.requests[(head + i) & m_queueMask].coord;
+
+    results.assign(count, Outcome());
+
+    auto &core = *channel.core.load(std::memory_order_acquire);
+    for(size_t i = 0; i < count;)
+    {
+        auto emptyCoord = core.getEmptyValueCoord();
+        auto batch      = core.applyMoves(coords.data() + i, count - i,
+                                          m_options.batchMode);
+
+        //The applied ones - Each tile went where the empty one was.
+        auto stop = i + batch.stopIndex;
+        for(; i < stop; ++i)
+        {
+            results[i].status  = Outcome::Status::Moved;
+            results[i].summary = makeSummary(emptyCoord, coords[i]);
+            emptyCoord         = coords[i];
+        }
+
+        if(batch.stopReason == GameCore::BatchResult::StopReason::InvalidMove)
+        {
+            results[i++].status = Outcome::Status::Invalid;
+        }
+        else if(batch.stopReason == GameCore::BatchResult::StopReason::GameOver)
+        {
+            for(; i < count; ++i)
+                results[i].status = Outcome::Status::GameOver;
+        }
+    }
+
+    auto gameStatus = core.getStatus();
+    auto movesCount = core.getMovesCount();
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        auto &request = channel.requests[(head + i) & m_queueMask];
+
+        results[i].gameStatus = gameStatus;
+        results[i].movesCount = movesCount;
+        if(request.callback)
+            request.callback(results[i]);
+
+        //Let go of what the callback holds.
+        request.callback = nullptr;
+    }
+
+    channel.head.store(head + count, std::memory_order_release);
+
+    //A move queued after this sees the flag down and schedules
+    //the Board - Or this sees the move and does it.
+    channel.scheduled.store(false, std::memory_order_seq_cst);
+    if(channel.tail.load(std::memory_order_seq_cst) != head + count &&
+       !channel.scheduled.exchange(true, std::memory_order_seq_cst))
+    {
+        schedule(board);
+    }
+}
+
+MovePipeline::Channel* MovePipeline::getChannel(BoardId board)
+{
+    if(board < 0 || board >= m_options.maxBoardsCount)
+        return nullptr;
+
+    auto &channel = m_channels[board];
+    if(!channel.core.load(std::memory_order_acquire))
+        return nullptr;
+
+    return &channel;
+}
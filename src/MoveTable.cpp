@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        MoveTable.cpp                             //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/MoveTable.h"
+//std
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int MoveTable::kNoNeighbor;
+const int MoveTable::kDirectionsCount;
+
+
+namespace {
+
+//Sizes up to 16 x 16 are found without the lock - Zero
+//(nullptr) initialized before any code runs, being static.
+const int kFastSidesCount = 16;
+std::atomic<const MoveTable *> s_fastTables[kFastSidesCount * kFastSidesCount];
+
+} //namespace
+
+
+// CTOR/DTOR //
+MoveTable::MoveTable(int width, int height) :
+    m_width (width),
+    m_height(height)
+{
+    auto count = width * height;
+
+    m_rows          .resize(count);
+    m_cols          .resize(count);
+    m_neighbors     .resize(count * kDirectionsCount);
+    m_neighborsMasks.resize(count);
+
+    for(int i = 0; i < count; ++i)
+    {
+        auto row = i / width;
+        auto col = i % width;
+
+        m_rows[i] = row;
+        m_cols[i] = col;
+
+        //Up, Down, Left, Right.
+        int32_t neighbors[kDirectionsCount] = {
+            (row > 0         ) ? i - width : kNoNeighbor,
+            (row < height - 1) ? i + width : kNoNeighbor,
+            (col > 0         ) ? i - 1     : kNoNeighbor,
+            (col < width  - 1) ? i + 1     : kNoNeighbor
+        };
+
+        uint8_t mask = 0;
+        for(int j = 0; j < kDirectionsCount; ++j)
+        {
+            m_neighbors[i * kDirectionsCount + j] = neighbors[j];
+            if(neighbors[j] != kNoNeighbor)
+                mask |= static_cast<uint8_t>(1 << j);
+        }
+
+        m_neighborsMasks[i] = mask;
+    }
+}
+
+
+// Static Methods //
+const MoveTable& MoveTable::get(int width, int height)
+{
+    //Fast path - A single load once the table was built.
+    auto isFast = (width  > 0 && width  <= kFastSidesCount &&
+                   height > 0 && height <= kFastSidesCount);
+
+    auto fastIndex = (height - 1) * kFastSidesCount + (width - 1);
+    if(isFast)
+    {
+        auto table = s_fastTables[fastIndex].load(std::memory_order_acquire);
+        if(table)
+            return *table;
+    }
+
+    //Slow path - First get() of the size (or a big one).
+    static std::mutex s_mutex;
+    static std::map<std::pair<int, int>,
+                    std::unique_ptr<MoveTable>> s_tables;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    auto &table = s_tables[std::make_pair(width, height)];
+    if(!table)
+        table.reset(new MoveTable(width, height));
+
+    if(isFast)
+        s_fastTables[fastIndex].store(table.get(), std::memory_order_release);
+
+    return *table;
+}
@@ -0,0 +1,401 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        ParallelSolver.cpp                        //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/ParallelSolver.h"
+//std
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+//CorePuzzle15
+#include "../include/BoardGenerator.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int ParallelSolver::kTasksPerThread;
+
+namespace {
+
+//Tasks of a thread - It takes from the back,
+//the others steal from the front.
+struct TaskQueue
+{
+    std::mutex         mutex;
+    std::deque<size_t> tasks;
+};
+
+void updateMin(std::atomic<int> &value, int candidate)
+{
+    auto current = value.load(std::memory_order_relaxed);
+    while(candidate < current &&
+          !value.compare_exchange_weak(current, candidate,
+                                       std::memory_order_relaxed))
+    {
+        //Empty...
+    }
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+ParallelSolver::ParallelSolver(const Options &options) :
+    m_options     (options),
+    m_threadsCount(options.threadsCount)
+{
+    if(m_threadsCount <= 0)
+        m_threadsCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_solvers.resize(m_threadsCount);
+    for(auto &solver : m_solvers)
+        solver.setPatternDatabase(options.database);
+}
+
+
+// Public Methods //
+ParallelSolver::Result ParallelSolver::solve(const GameCore &core,
+                                             const Clock::time_point &deadline)
+{
+    return solve(core.getFlatBoard(), deadline);
+}
+
+ParallelSolver::Result ParallelSolver::solve(const FlatBoard &board,
+                                             const Clock::time_point &deadline)
+{
+    Result result;
+
+    if(!BoardGenerator::isSolvable(board))
+    {
+        result.status = Result::Status::Unsolvable;
+        return result;
+    }
+
+    auto fitsSolver = (board.getCellsCount() <= Solver::kMaxCellsCount);
+
+    //A solution to fall back on.
+    auto knownLength = -1;
+    if(m_options.mode != Mode::Optimal)
+    {
+        m_reduction.setDeadline(deadline);
+        auto reduced = m_reduction.solve(board);
+
+        if(reduced.status == ReductionSolver::Result::Status::Solved)
+        {
+            result.status = Result::Status::Suboptimal;
+            result.moves  = std::move(reduced.moves);
+            knownLength   = static_cast<int>(result.moves.size());
+        }
+        else if(reduced.status == ReductionSolver::Result::Status::Timeout)
+        {
+            result.status = Result::Status::Timeout;
+        }
+
+        if(m_options.mode == Mode::Fast || !fitsSolver ||
+           result.status != Result::Status::Suboptimal)
+        {
+            return result;
+        }
+    }
+    else if(!fitsSolver)
+    {
+        return result;
+    }
+
+    std::vector<int> path;
+    auto status = searchOptimal(board, deadline, knownLength,
+                                path, result.expandedNodes);
+
+    if(status == Result::Status::Optimal)
+    {
+        result.status = Result::Status::Optimal;
+        result.moves.clear();
+        for(auto index : path)
+            result.moves.push_back(board.getCoord(index));
+    }
+    //Nothing is shorter than the known solution.
+    else if(status == Result::Status::Suboptimal)
+    {
+        result.status = Result::Status::Optimal;
+    }
+    else if(knownLength == -1)
+    {
+        result.status = status;
+    }
+
+    return result;
+}
+
+
+const ParallelSolver::Options& ParallelSolver::getOptions() const
+{
+    return m_options;
+}
+
+
+// Private Methods //
+//Returns Optimal with path, Suboptimal if no solution is shorter
+//than knownLength (when it's not -1), Timeout or Unsolvable.
+ParallelSolver::Result::Status ParallelSolver::searchOptimal(
+    const FlatBoard         &board,
+    const Clock::time_point &deadline,
+    int                      knownLength,
+    std::vector<int>        &path,
+    uint64_t                &expandedNodes)
+{
+    std::atomic<bool> stop(false);
+
+    for(auto &solver : m_solvers)
+    {
+        solver.setDeadline(deadline);
+        solver.initTables(board);
+        solver.m_stop = &stop;
+    }
+
+    auto &root  = m_solvers[0];
+    auto  bound = root.getHeuristic();
+    if(bound == 0)
+        return Result::Status::Optimal;
+
+    std::vector<std::vector<int>> tasks;
+    std::unique_ptr<TaskQueue[]>  queues(new TaskQueue[m_threadsCount]);
+
+    //IDA* - Deepen the bound to the smallest f that went past it.
+    for(;; bound = root.m_nextBound)
+    {
+        if(knownLength != -1 && bound >= knownLength)
+            return Result::Status::Suboptimal;
+
+        //Nothing went past the bound - Nowhere else to look.
+        if(bound == INT_MAX)
+            return Result::Status::Unsolvable;
+
+        if(Clock::now() >= deadline)
+            return Result::Status::Timeout;
+
+        root.m_nextBound = INT_MAX;
+        if(expandFrontier(bound, root.m_nextBound, tasks, path, expandedNodes))
+            return Result::Status::Optimal;
+
+        if(tasks.empty())
+            continue;
+
+        for(size_t i = 0; i < tasks.size(); ++i)
+            queues[i % m_threadsCount].tasks.push_back(i);
+
+        std::atomic<int>      nextBound(root.m_nextBound);
+        std::atomic<uint64_t> expanded (0);
+        std::atomic<bool>     found    (false);
+        std::atomic<bool>     timeout  (false);
+        std::mutex            pathMutex;
+
+        auto work = [&](int threadIndex) {
+            auto &solver = m_solvers[threadIndex];
+            std::vector<Solver::MoveUndo> undos;
+
+            while(!stop.load(std::memory_order_relaxed))
+            {
+                //Own tasks first, then steal.
+                auto taken = false;
+                auto task  = size_t(0);
+                for(int i = 0; i < m_threadsCount && !taken; ++i)
+                {
+                    auto &queue = queues[(threadIndex + i) % m_threadsCount];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+
+                    if(queue.tasks.empty())
+                        continue;
+
+                    taken = true;
+                    if(i == 0)
+                    {
+                        task = queue.tasks.back();
+                        queue.tasks.pop_back();
+                    }
+                    else
+                    {
+                        task = queue.tasks.front();
+                        queue.tasks.pop_front();
+                    }
+                }
+
+                if(!taken)
+                    break;
+
+                //Go down to the task node and search below it.
+                const auto &taskPath = tasks[task];
+                undos.resize(taskPath.size());
+                for(size_t i = 0; i < taskPath.size(); ++i)
+                    solver.doMove(taskPath[i], undos[i]);
+
+                solver.m_bound         = bound;
+                solver.m_nextBound     = INT_MAX;
+                solver.m_aborted       = false;
+                solver.m_expandedNodes = 0;
+                solver.m_path          = taskPath;
+
+                auto solved = solver.search(
+                    static_cast<int>(taskPath.size()),
+                    taskPath.empty() ? -1 : undos.back().emptyIndex
+                );
+
+                expanded.fetch_add(solver.m_expandedNodes,
+                                   std::memory_order_relaxed);
+                if(solved)
+                {
+                    std::lock_guard<std::mutex> lock(pathMutex);
+                    if(!found.exchange(true))
+                        path = solver.m_path;
+
+                    stop.store(true);
+                    break;
+                }
+
+                for(auto i = taskPath.size(); i > 0; --i)
+                    solver.undoMove(undos[i - 1]);
+
+                if(solver.m_aborted)
+                {
+                    timeout.store(true);
+                    stop   .store(true);
+                    break;
+                }
+
+                updateMin(nextBound, solver.m_nextBound);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for(int i = 1; i < m_threadsCount; ++i)
+            threads.emplace_back(work, i);
+
+        work(0);
+        for(auto &thread : threads)
+            thread.join();
+
+        expandedNodes += expanded;
+
+        if(found)
+            return Result::Status::Optimal;
+
+        if(timeout)
+            return Result::Status::Timeout;
+
+        root.m_nextBound = nextBound;
+        for(int i = 0; i < m_threadsCount; ++i)
+            queues[i].tasks.clear();
+    }
+}
+
+bool ParallelSolver::expandFrontier(int bound, int &nextBound,
+                                    std::vector<std::vector<int>> &tasks,
+                                    std::vector<int> &path,
+                                    uint64_t &expandedNodes)
+{
+    auto &root   = m_solvers[0];
+    auto  target = static_cast<size_t>(m_threadsCount) * kTasksPerThread;
+
+    //Level by level from the root, until there's enough
+    //nodes (or none) - Each one is the path to it.
+    std::vector<std::vector<int>> level(1);
+    std::vector<Solver::MoveUndo> undos;
+
+    while(!level.empty() && level.size() < target)
+    {
+        tasks.clear();
+        for(const auto &node : level)
+        {
+            undos.resize(node.size());
+            for(size_t i = 0; i < node.size(); ++i)
+                root.doMove(node[i], undos[i]);
+
+            ++expandedNodes;
+
+            auto emptyIndex = root.m_emptyIndex;
+            auto prevIndex  = node.empty() ? -1 : undos.back().emptyIndex;
+            auto cost       = static_cast<int>(node.size()) + 1;
+
+            for(int i = 0; i < root.m_neighborsCount[emptyIndex]; ++i)
+            {
+                int index = root.m_neighbors[emptyIndex][i];
+                if(index == prevIndex)
+                    continue;
+
+                Solver::MoveUndo undo;
+                root.doMove(index, undo);
+
+                auto h = root.getHeuristic();
+                auto f = cost + h;
+
+                if(f > bound)
+                {
+                    nextBound = std::min(nextBound, f);
+                }
+                else
+                {
+                    tasks.push_back(node);
+                    tasks.back().push_back(index);
+
+                    if(h == 0)
+                        path = tasks.back();
+                }
+
+                root.undoMove(undo);
+            }
+
+            for(auto i = node.size(); i > 0; --i)
+                root.undoMove(undos[i - 1]);
+
+            if(!path.empty())
+                return true;
+        }
+
+        level.swap(tasks);
+    }
+
+    tasks.swap(level);
+    return false;
+}
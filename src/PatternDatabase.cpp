@@ -0,0 +1,571 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PatternDatabase.cpp                       //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/PatternDatabase.h"
+//std
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+//POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+//CorePuzzle15
+#include "../include/Heuristics.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+namespace {
+
+const char     kFileMagic[8] = { 'C', 'P', '1', '5', 'P', 'D', 'B', '\0' };
+const uint32_t kFileVersion  = 1;
+const uint64_t kTableAlign   = 4096; //Page size - Keeps tables mmap friendly.
+const uint8_t  kUnvisited    = 0xFF;
+const int      kMaxEntry     = 0x0F;
+
+struct FileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t patternsCount;
+    uint8_t  reserved[40];
+};
+
+struct FilePattern
+{
+    uint8_t  tilesCount;
+    uint8_t  tiles[PatternDatabase::kMaxPatternTilesCount];
+    uint8_t  reserved[7];
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(FileHeader ) == 64, "FileHeader must be 64 bytes");
+static_assert(sizeof(FilePattern) == 32, "FilePattern must be 32 bytes");
+
+
+uint64_t entriesCount(int tilesCount, int cellsCount)
+{
+    //cellsCount! / (cellsCount - tilesCount)!
+    uint64_t count = 1;
+    for(int i = 0; i < tilesCount; ++i)
+        count *= cellsCount - i;
+
+    return count;
+}
+
+void unrank(uint64_t rank, int tilesCount, int cellsCount, uint8_t *positions)
+{
+    int digits[PatternDatabase::kMaxPatternTilesCount];
+    for(int i = tilesCount -1; i >= 0; --i)
+    {
+        digits[i] = static_cast<int>(rank % (cellsCount - i));
+        rank     /= (cellsCount - i);
+    }
+
+    //Each digit is the index of the position among the unused cells.
+    uint64_t used = 0;
+    for(int i = 0; i < tilesCount; ++i)
+    {
+        int cell = 0;
+        for(int free = digits[i]; ; ++cell)
+        {
+            if(used & (1ull << cell))
+                continue;
+            if(free-- == 0)
+                break;
+        }
+
+        positions[i] = static_cast<uint8_t>(cell);
+        used        |= (1ull << cell);
+    }
+}
+
+int patternManhattan(const uint8_t *positions, const std::vector<int> &tiles,
+                     int width, int cellsCount)
+{
+    int distance = 0;
+    for(size_t i = 0; i < tiles.size(); ++i)
+    {
+        distance += Heuristics::getTileDistance(tiles[i], positions[i],
+                                                width, cellsCount);
+    }
+
+    return distance;
+}
+
+//Grows seed to all the free cells connected to it.
+uint32_t floodFill(uint32_t seed, uint32_t free, int width, int cellsCount)
+{
+    //Cells that can move left/right without wrapping to another row.
+    uint32_t notFirstCol = 0;
+    uint32_t notLastCol  = 0;
+    for(int i = 0; i < cellsCount; ++i)
+    {
+        if(i % width != 0       ) notFirstCol |= (1u << i);
+        if(i % width != width -1) notLastCol  |= (1u << i);
+    }
+
+    auto region = seed;
+    while(true)
+    {
+        auto grown = region
+                   | (region << width)
+                   | (region >> width)
+                   | ((region & notLastCol ) << 1)
+                   | ((region & notFirstCol) >> 1);
+        grown &= free;
+
+        if(grown == region)
+            return region;
+
+        region = grown;
+    }
+}
+
+bool buildTable(int width, int height, const std::vector<int> &tiles,
+                std::vector<uint8_t> &table)
+{
+    auto cellsCount = width * height;
+    auto tilesCount = static_cast<int>(tiles.size());
+    auto count      = entriesCount(tilesCount, cellsCount);
+    auto allCells   = (cellsCount == 32) ? UINT32_MAX : (1u << cellsCount) -1;
+
+    //Layers hold the ranks as 32 bits.
+    if(count > UINT32_MAX)
+        return false;
+
+    //A state is the placement of the pattern tiles plus the region
+    //of free cells where the empty tile is - It moves for free inside
+    //of it, only moving a pattern tile into it has a cost.
+    //regions[rank] has all the cells that the empty tile was seen.
+    std::vector<uint8_t > distances(count, kUnvisited);
+    std::vector<uint32_t> regions  (count, 0);
+
+    //Breadth first (by pattern moves) from the solved placement.
+    uint8_t positions[PatternDatabase::kMaxPatternTilesCount];
+    for(int i = 0; i < tilesCount; ++i)
+        positions[i] = static_cast<uint8_t>(Heuristics::getGoalIndex(tiles[i], cellsCount));
+
+    struct State { uint32_t rank; uint32_t emptyCell; };
+
+    uint32_t occupied = 0;
+    for(int i = 0; i < tilesCount; ++i)
+        occupied |= (1u << positions[i]);
+
+    auto start = PatternDatabase::rank(positions, tilesCount, cellsCount);
+    distances[start] = 0;
+    regions  [start] = floodFill(1u << (cellsCount -1), allCells & ~occupied,
+                                 width, cellsCount);
+
+    std::vector<State> layer(1, State{ static_cast<uint32_t>(start),
+                                       static_cast<uint32_t>(cellsCount -1) });
+    std::vector<State> nextLayer;
+
+    for(int depth = 0; !layer.empty(); ++depth)
+    {
+        nextLayer.clear();
+        for(const auto &state : layer)
+        {
+            unrank(state.rank, tilesCount, cellsCount, positions);
+
+            occupied = 0;
+            for(int i = 0; i < tilesCount; ++i)
+                occupied |= (1u << positions[i]);
+
+            auto region = floodFill(1u << state.emptyCell,
+                                    allCells & ~occupied,
+                                    width, cellsCount);
+
+            for(int i = 0; i < tilesCount; ++i)
+            {
+                auto cell = positions[i];
+                auto row  = cell / width;
+                auto col  = cell % width;
+
+                int neighbors[4];
+                int neighborsCount = 0;
+                if(row > 0        ) neighbors[neighborsCount++] = cell - width;
+                if(row < height -1) neighbors[neighborsCount++] = cell + width;
+                if(col > 0        ) neighbors[neighborsCount++] = cell - 1;
+                if(col < width  -1) neighbors[neighborsCount++] = cell + 1;
+
+                //The tile slides into the empty tile, which takes it's place.
+                for(int j = 0; j < neighborsCount; ++j)
+                {
+                    if(!(region & (1u << neighbors[j])))
+                        continue;
+
+                    positions[i]  = static_cast<uint8_t>(neighbors[j]);
+                    auto nextRank = PatternDatabase::rank(positions, tilesCount, cellsCount);
+                    positions[i]  = cell;
+
+                    if(regions[nextRank] & (1u << cell))
+                        continue;
+
+                    //Mark now, so the same region isn't queued twice.
+                    auto nextOccupied = (occupied & ~(1u << cell)) | (1u << neighbors[j]);
+                    regions[nextRank] |= floodFill(1u << cell,
+                                                   allCells & ~nextOccupied,
+                                                   width, cellsCount);
+
+                    if(distances[nextRank] == kUnvisited)
+                        distances[nextRank] = static_cast<uint8_t>(depth + 1);
+
+                    nextLayer.push_back(State{ static_cast<uint32_t>(nextRank),
+                                               static_cast<uint32_t>(cell) });
+                }
+            }
+        }
+        layer.swap(nextLayer);
+    }
+
+    //Pack - Two entries per byte, low nibble first.
+    table.assign((count + 1) / 2, 0);
+    for(uint64_t rank = 0; rank < count; ++rank)
+    {
+        unrank(rank, tilesCount, cellsCount, positions);
+
+        auto manhattan = patternManhattan(positions, tiles, width, cellsCount);
+        auto entry     = std::min((distances[rank] - manhattan) / 2, kMaxEntry);
+
+        table[rank >> 1] |= static_cast<uint8_t>(entry << ((rank & 1) * 4));
+    }
+
+    return true;
+}
+
+} //anonymous namespace
+
+
+// CTOR/DTOR //
+PatternDatabase::PatternDatabase() :
+    m_mapping      (nullptr),
+    m_mappingSize  (0),
+    m_width        (0),
+    m_height       (0),
+    m_patternsCount(0)
+{
+    //Empty...
+}
+
+PatternDatabase::~PatternDatabase()
+{
+    unload();
+}
+
+
+// Static Methods //
+PatternDatabase::Patterns PatternDatabase::getDefaultPatterns(int width,
+                                                              int height)
+{
+    if(width == 4 && height == 4)
+    {
+        return {
+            {  1,  5,  6,  9, 10, 13 },
+            {  7,  8, 11, 12, 14, 15 },
+            {  2,  3,  4             },
+        };
+    }
+
+    if(width == 5 && height == 5)
+    {
+        return {
+            {  1,  2,  5,  6,  7, 12 },
+            {  3,  4,  8,  9, 13, 14 },
+            { 10, 11, 15, 16, 20, 21 },
+            { 17, 18, 19, 22, 23, 24 },
+        };
+    }
+
+    return Patterns();
+}
+
+bool PatternDatabase::build(int width, int height,
+                            const Patterns &patterns,
+                            const std::string &path)
+{
+    auto cellsCount = width * height;
+    if(cellsCount > kMaxCellsCount                             ||
+       patterns.empty()                                        ||
+       patterns.size() > static_cast<size_t>(kMaxPatternsCount))
+    {
+        return false;
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version       = kFileVersion;
+    header.width         = width;
+    header.height        = height;
+    header.patternsCount = static_cast<uint32_t>(patterns.size());
+
+    std::vector<FilePattern> filePatterns(patterns.size());
+    std::memset(filePatterns.data(), 0, filePatterns.size() * sizeof(FilePattern));
+
+    //The patterns must be disjoint, so their sum is admissible.
+    bool taken[kMaxCellsCount] = {};
+
+    uint64_t offset = kTableAlign;
+    for(size_t i = 0; i < patterns.size(); ++i)
+    {
+        const auto &tiles = patterns[i];
+        if(tiles.empty() || tiles.size() > static_cast<size_t>(kMaxPatternTilesCount))
+            return false;
+
+        auto &filePattern = filePatterns[i];
+        filePattern.tilesCount = static_cast<uint8_t>(tiles.size());
+        for(size_t j = 0; j < tiles.size(); ++j)
+        {
+            if(tiles[j] <= 0 || tiles[j] >= cellsCount || taken[tiles[j]])
+                return false;
+
+            taken[tiles[j]]      = true;
+            filePattern.tiles[j] = static_cast<uint8_t>(tiles[j]);
+        }
+
+        filePattern.offset = offset;
+        filePattern.size   = (entriesCount(static_cast<int>(tiles.size()), cellsCount) + 1) / 2;
+
+        offset += (filePattern.size + kTableAlign -1) / kTableAlign * kTableAlign;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file)
+        return false;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(filePatterns.data()),
+               filePatterns.size() * sizeof(FilePattern));
+
+    //Tables are built one at time, so only one is in memory.
+    std::vector<uint8_t> table;
+    for(size_t i = 0; i < patterns.size(); ++i)
+    {
+        if(!buildTable(width, height, patterns[i], table))
+            return false;
+
+        file.seekp(filePatterns[i].offset);
+        file.write(reinterpret_cast<const char *>(table.data()), table.size());
+    }
+
+    return static_cast<bool>(file);
+}
+
+uint64_t PatternDatabase::rank(const uint8_t *positions, int tilesCount,
+                               int cellsCount)
+{
+    //Mixed radix - The i-th digit is the index of positions[i]
+    //among the cells not taken by the previous tiles.
+    uint64_t rank = 0;
+    for(int i = 0; i < tilesCount; ++i)
+    {
+        int digit = positions[i];
+        for(int j = 0; j < i; ++j)
+            digit -= (positions[j] < positions[i]);
+
+        rank = rank * (cellsCount - i) + digit;
+    }
+
+    return rank;
+}
+
+
+// Public Methods //
+bool PatternDatabase::load(const std::string &path)
+{
+    unload();
+
+    auto fd = open(path.c_str(), O_RDONLY);
+    if(fd == -1)
+        return false;
+
+    struct stat info;
+    if(fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(FileHeader))
+    {
+        close(fd);
+        return false;
+    }
+
+    auto size    = static_cast<size_t>(info.st_size);
+    auto mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); //The mapping keeps the file alive.
+
+    if(mapping == MAP_FAILED)
+        return false;
+
+    m_mapping     = mapping;
+    m_mappingSize = size;
+
+    //Validate everything before trusting any offset.
+    auto bytes  = static_cast<const uint8_t *>(mapping);
+    auto header = reinterpret_cast<const FileHeader *>(bytes);
+
+    auto cellsCount = static_cast<int>(header->width * header->height);
+    auto valid = std::memcmp(header->magic, kFileMagic, sizeof(kFileMagic)) == 0
+              && header->version       == kFileVersion
+              && cellsCount            <= kMaxCellsCount
+              && header->patternsCount >  0
+              && header->patternsCount <= static_cast<uint32_t>(kMaxPatternsCount)
+              && sizeof(FileHeader) + header->patternsCount * sizeof(FilePattern) <= size;
+
+    if(!valid)
+    {
+        unload();
+        return false;
+    }
+
+    m_width         = static_cast<int>(header->width);
+    m_height        = static_cast<int>(header->height);
+    m_patternsCount = static_cast<int>(header->patternsCount);
+
+    //Same checks of the tiles as build() - A tile out of Board
+    //would index out of the cells, and one in two patterns would
+    //make the heuristic inadmissible.
+    bool taken[kMaxCellsCount] = {};
+
+    auto filePatterns = reinterpret_cast<const FilePattern *>(bytes + sizeof(FileHeader));
+    for(int i = 0; i < m_patternsCount; ++i)
+    {
+        const auto &filePattern = filePatterns[i];
+        auto tilesCount = static_cast<int>(filePattern.tilesCount);
+
+        if(tilesCount == 0 || tilesCount > kMaxPatternTilesCount ||
+           filePattern.size   != (entriesCount(tilesCount, cellsCount) + 1) / 2 ||
+           filePattern.offset >  size                                          ||
+           filePattern.size   >  size - filePattern.offset)
+        {
+            unload();
+            return false;
+        }
+
+        m_tilesCount[i] = tilesCount;
+        for(int j = 0; j < tilesCount; ++j)
+        {
+            auto tile = static_cast<int>(filePattern.tiles[j]);
+            if(tile <= 0 || tile >= cellsCount || taken[tile])
+            {
+                unload();
+                return false;
+            }
+
+            taken[tile]   = true;
+            m_tiles[i][j] = tile;
+        }
+
+        m_tables[i] = bytes + filePattern.offset;
+    }
+
+    return true;
+}
+
+void PatternDatabase::unload()
+{
+    if(m_mapping)
+        munmap(m_mapping, m_mappingSize);
+
+    m_mapping       = nullptr;
+    m_mappingSize   = 0;
+    m_width         = 0;
+    m_height        = 0;
+    m_patternsCount = 0;
+}
+
+bool PatternDatabase::isLoaded() const
+{
+    return m_mapping != nullptr;
+}
+
+
+int PatternDatabase::getWidth() const
+{
+    return m_width;
+}
+
+int PatternDatabase::getHeight() const
+{
+    return m_height;
+}
+
+int PatternDatabase::getPatternsCount() const
+{
+    return m_patternsCount;
+}
+
+int PatternDatabase::getPatternTilesCount(int pattern) const
+{
+    return m_tilesCount[pattern];
+}
+
+int PatternDatabase::getPatternTile(int pattern, int index) const
+{
+    return m_tiles[pattern][index];
+}
+
+
+int PatternDatabase::getHeuristic(const FlatBoard &board) const
+{
+    auto cellsCount = board.getCellsCount();
+
+    //Where each value is.
+    uint8_t cells[kMaxCellsCount];
+    for(int i = 0; i < cellsCount; ++i)
+        cells[board.getValueAt(i)] = static_cast<uint8_t>(i);
+
+    auto heuristic = Heuristics::manhattanDistance(board);
+    for(int i = 0; i < m_patternsCount; ++i)
+    {
+        uint8_t positions[kMaxPatternTilesCount];
+        for(int j = 0; j < m_tilesCount[i]; ++j)
+            positions[j] = cells[m_tiles[i][j]];
+
+        heuristic += 2 * getEntry(i, rank(positions, m_tilesCount[i], cellsCount));
+    }
+
+    return heuristic;
+}
@@ -0,0 +1,271 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PuzzleBank.cpp                            //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/PuzzleBank.h"
+//std
+#include <algorithm>
+#include <cstring>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const uint32_t PuzzleBank::kVersion;
+const uint32_t PuzzleBank::kBlockSize;
+const char     PuzzleBank::kMagic[8] = { 'C', 'P', '1', '5', 'B', 'N', 'K', '\0' };
+
+static_assert(sizeof(PuzzleBank::FileHeader) == 64, "FileHeader must be 64 bytes");
+static_assert(sizeof(PuzzleBank::FileBucket) == 40, "FileBucket must be 40 bytes");
+
+
+// CTOR/DTOR //
+PuzzleBank::PuzzleBank() :
+    m_offset      (0),
+    m_puzzlesCount(0),
+    m_source      (Source::GameCoreSeeds),
+    m_seriesSeed  (0)
+{
+    //Empty...
+}
+
+PuzzleBank::~PuzzleBank()
+{
+    close();
+}
+
+
+// Public Methods //
+bool PuzzleBank::open(const std::string &path)
+{
+    close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if(!m_file)
+        return false;
+
+    //Room for the header - It's written by close().
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    m_offset       = sizeof(header);
+    m_puzzlesCount = 0;
+    m_source       = Source::GameCoreSeeds;
+    m_seriesSeed   = 0;
+
+    return static_cast<bool>(m_file);
+}
+
+bool PuzzleBank::setSource(Source source, uint64_t seriesSeed)
+{
+    if(source != Source::Series)
+        seriesSeed = 0;
+
+    //All puzzles must have the same source.
+    if(m_puzzlesCount != 0 && (source != m_source || seriesSeed != m_seriesSeed))
+        return false;
+
+    m_source     = source;
+    m_seriesSeed = seriesSeed;
+
+    return true;
+}
+
+bool PuzzleBank::add(const Puzzle &puzzle)
+{
+    if(!isOpen())
+        return false;
+
+    auto width  = puzzle.board.getWidth ();
+    auto height = puzzle.board.getHeight();
+
+    auto key = BucketKey(width, height, puzzle.difficulty);
+    auto it  = m_buckets.find(key);
+    if(it == m_buckets.end())
+    {
+        Bucket bucket;
+        bucket.puzzleSize        = getPuzzleSize(width, height);
+        bucket.blockPuzzlesCount = std::max(1u, kBlockSize / bucket.puzzleSize);
+        bucket.puzzlesCount      = 0;
+
+        it = m_buckets.insert(std::make_pair(key, std::move(bucket))).first;
+        it->second.pending.reserve(
+            it->second.blockPuzzlesCount * it->second.puzzleSize
+        );
+    }
+
+    auto &bucket = it->second;
+    auto  seed   = static_cast<int32_t>(puzzle.seed);
+    auto  cells  = puzzle.board.getCellsBytes();
+
+    auto seedBytes = reinterpret_cast<const uint8_t *>(&seed);
+    bucket.pending.insert(bucket.pending.end(), seedBytes, seedBytes + sizeof(seed));
+    bucket.pending.insert(bucket.pending.end(),
+                          cells,
+                          cells + bucket.puzzleSize - sizeof(seed));
+
+    ++bucket.puzzlesCount;
+    ++m_puzzlesCount;
+
+    if(bucket.pending.size() == bucket.blockPuzzlesCount * bucket.puzzleSize)
+        return writeBlock(bucket);
+
+    return true;
+}
+
+bool PuzzleBank::close()
+{
+    if(!isOpen())
+        return false;
+
+    //Last blocks, partially filled.
+    for(auto &pair : m_buckets)
+        writeBlock(pair.second);
+
+    //Index - Aligned, so the reader can use it in place.
+    static const char kPadding[sizeof(uint64_t)] = {};
+    auto paddingSize = (sizeof(uint64_t) - m_offset % sizeof(uint64_t)) % sizeof(uint64_t);
+    m_file.write(kPadding, paddingSize);
+    m_offset += paddingSize;
+
+    //The map is already sorted by (width, height, difficulty).
+    std::vector<FileBucket> fileBuckets;
+    auto blocksOffset = m_offset + m_buckets.size() * sizeof(FileBucket);
+
+    for(const auto &pair : m_buckets)
+    {
+        const auto &bucket = pair.second;
+
+        FileBucket fileBucket;
+        fileBucket.width             = static_cast<uint32_t>(std::get<0>(pair.first));
+        fileBucket.height            = static_cast<uint32_t>(std::get<1>(pair.first));
+        fileBucket.difficulty        = static_cast<int32_t >(std::get<2>(pair.first));
+        fileBucket.puzzleSize        = bucket.puzzleSize;
+        fileBucket.puzzlesCount      = bucket.puzzlesCount;
+        fileBucket.blockPuzzlesCount = bucket.blockPuzzlesCount;
+        fileBucket.blocksCount       = static_cast<uint32_t>(bucket.blockOffsets.size());
+        fileBucket.blocksOffset      = blocksOffset;
+
+        fileBuckets.push_back(fileBucket);
+        blocksOffset += bucket.blockOffsets.size() * sizeof(uint64_t);
+    }
+
+    m_file.write(reinterpret_cast<const char *>(fileBuckets.data()),
+                 fileBuckets.size() * sizeof(FileBucket));
+
+    for(const auto &pair : m_buckets)
+    {
+        const auto &offsets = pair.second.blockOffsets;
+        m_file.write(reinterpret_cast<const char *>(offsets.data()),
+                     offsets.size() * sizeof(uint64_t));
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version      = kVersion;
+    header.bucketsCount = static_cast<uint32_t>(m_buckets.size());
+    header.indexOffset  = m_offset;
+    header.puzzlesCount = m_puzzlesCount;
+    header.source       = static_cast<uint32_t>(m_source);
+    header.seriesSeed   = m_seriesSeed;
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    auto good = static_cast<bool>(m_file);
+    m_file.close();
+    m_buckets.clear();
+
+    return good;
+}
+
+bool PuzzleBank::isOpen() const
+{
+    return m_file.is_open();
+}
+
+uint64_t PuzzleBank::getPuzzlesCount(int width, int height, int difficulty) const
+{
+    auto it = m_buckets.find(BucketKey(width, height, difficulty));
+    return (it != m_buckets.end()) ? it->second.puzzlesCount : 0;
+}
+
+uint64_t PuzzleBank::getPuzzlesCount() const
+{
+    return m_puzzlesCount;
+}
+
+PuzzleBank::Source PuzzleBank::getSource() const
+{
+    return m_source;
+}
+
+uint64_t PuzzleBank::getSeriesSeed() const
+{
+    return m_seriesSeed;
+}
+
+
+// Static Methods //
+uint32_t PuzzleBank::getPuzzleSize(int width, int height)
+{
+    auto count = width * height;
+    return static_cast<uint32_t>(sizeof(int32_t) + count * FlatBoard::cellSizeFor(count));
+}
+
+
+// Private Methods //
+bool PuzzleBank::writeBlock(Bucket &bucket)
+{
+    if(bucket.pending.empty())
+        return true;
+
+    m_file.write(reinterpret_cast<const char *>(bucket.pending.data()),
+                 bucket.pending.size());
+
+    bucket.blockOffsets.push_back(m_offset);
+    m_offset += bucket.pending.size();
+    bucket.pending.clear();
+
+    return static_cast<bool>(m_file);
+}
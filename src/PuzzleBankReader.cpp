@@ -0,0 +1,310 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PuzzleBankReader.cpp                      //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/PuzzleBankReader.h"
+//std
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+//POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+namespace {
+
+std::tuple<int, int, int> getKey(const PuzzleBank::FileBucket &bucket)
+{
+    return std::make_tuple(static_cast<int>(bucket.width),
+                           static_cast<int>(bucket.height),
+                           static_cast<int>(bucket.difficulty));
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+PuzzleBankReader::PuzzleBankReader() :
+    m_mapping(nullptr),
+    m_size   (0),
+    m_data   (nullptr),
+    m_header (nullptr),
+    m_buckets(nullptr)
+{
+    //Empty...
+}
+
+PuzzleBankReader::~PuzzleBankReader()
+{
+    close();
+}
+
+
+// Public Methods //
+bool PuzzleBankReader::load(const std::string &path)
+{
+    close();
+
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if(fd == -1)
+        return false;
+
+    struct stat info;
+    if(fstat(fd, &info) == -1 ||
+       static_cast<size_t>(info.st_size) < sizeof(PuzzleBank::FileHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    auto size    = static_cast<size_t>(info.st_size);
+    auto mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); //The mapping keeps the file alive.
+
+    if(mapping == MAP_FAILED)
+        return false;
+
+    //Lookups jump all over the file.
+    madvise(mapping, size, MADV_RANDOM);
+
+    m_mapping = mapping;
+    m_size    = size;
+    m_data    = static_cast<const uint8_t *>(mapping);
+
+    if(!readIndex())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void PuzzleBankReader::close()
+{
+    if(m_mapping)
+        munmap(m_mapping, m_size);
+
+    m_mapping = nullptr;
+    m_size    = 0;
+    m_data    = nullptr;
+    m_header  = nullptr;
+    m_buckets = nullptr;
+}
+
+bool PuzzleBankReader::isOpen() const
+{
+    return m_header != nullptr;
+}
+
+
+uint64_t PuzzleBankReader::getPuzzlesCount() const
+{
+    return isOpen() ? m_header->puzzlesCount : 0;
+}
+
+uint64_t PuzzleBankReader::getPuzzlesCount(int width, int height,
+                                           int difficulty) const
+{
+    auto bucket = findBucket(width, height, difficulty);
+    return bucket ? bucket->puzzlesCount : 0;
+}
+
+PuzzleBank::Source PuzzleBankReader::getSource() const
+{
+    return isOpen() ? static_cast<PuzzleBank::Source>(m_header->source)
+                    : PuzzleBank::Source::GameCoreSeeds;
+}
+
+uint64_t PuzzleBankReader::getSeriesSeed() const
+{
+    return isOpen() ? m_header->seriesSeed : 0;
+}
+
+std::vector<PuzzleBankReader::BucketInfo> PuzzleBankReader::getBuckets() const
+{
+    std::vector<BucketInfo> buckets;
+    if(!isOpen())
+        return buckets;
+
+    buckets.reserve(m_header->bucketsCount);
+    for(uint32_t i = 0; i < m_header->bucketsCount; ++i)
+    {
+        BucketInfo info;
+        info.width        = static_cast<int>(m_buckets[i].width);
+        info.height       = static_cast<int>(m_buckets[i].height);
+        info.difficulty   = static_cast<int>(m_buckets[i].difficulty);
+        info.puzzlesCount = m_buckets[i].puzzlesCount;
+
+        buckets.push_back(info);
+    }
+
+    return buckets;
+}
+
+bool PuzzleBankReader::get(int width, int height, int difficulty,
+                           uint64_t index, PuzzleBank::Puzzle &puzzle) const
+{
+    auto bucket = findBucket(width, height, difficulty);
+    if(!bucket || index >= bucket->puzzlesCount)
+        return false;
+
+    //All blocks but the last are full.
+    const uint64_t *blockOffsets = reinterpret_cast<const uint64_t *>(
+        m_data + bucket->blocksOffset
+    );
+    auto offset = blockOffsets[index / bucket->blockPuzzlesCount]
+                + (index % bucket->blockPuzzlesCount) * bucket->puzzleSize;
+
+    int32_t seed;
+    std::memcpy(&seed, m_data + offset, sizeof(seed));
+
+    puzzle.seed       = seed;
+    puzzle.difficulty = difficulty;
+    puzzle.board.resize(width, height);
+    std::memcpy(puzzle.board.getCellsBytes(),
+                m_data + offset + sizeof(seed),
+                bucket->puzzleSize - sizeof(seed));
+
+    return true;
+}
+
+
+// Private Methods //
+bool PuzzleBankReader::readIndex()
+{
+    //Version 1 has zeros where the source is - Source::GameCoreSeeds.
+    auto header = reinterpret_cast<const PuzzleBank::FileHeader *>(m_data);
+    if(std::memcmp(header->magic, PuzzleBank::kMagic, sizeof(PuzzleBank::kMagic)) != 0 ||
+       (header->version != 1 && header->version != PuzzleBank::kVersion)               ||
+       header->source > static_cast<uint32_t>(PuzzleBank::Source::Series))
+    {
+        return false;
+    }
+
+    auto bucketsSize = uint64_t(header->bucketsCount) * sizeof(PuzzleBank::FileBucket);
+    if(header->indexOffset > m_size || bucketsSize > m_size - header->indexOffset ||
+       header->indexOffset % sizeof(uint64_t) != 0)
+    {
+        return false;
+    }
+
+    auto buckets = reinterpret_cast<const PuzzleBank::FileBucket *>(
+        m_data + header->indexOffset
+    );
+
+    //Check every block, so get() never reads out of the file.
+    for(uint32_t i = 0; i < header->bucketsCount; ++i)
+    {
+        const auto &bucket = buckets[i];
+        if(bucket.width == 0 || bucket.height == 0 ||
+           bucket.puzzleSize != PuzzleBank::getPuzzleSize(bucket.width, bucket.height) ||
+           bucket.blockPuzzlesCount == 0)
+        {
+            return false;
+        }
+
+        auto blocksCount = (bucket.puzzlesCount + bucket.blockPuzzlesCount -1)
+                         / bucket.blockPuzzlesCount;
+        auto blocksSize  = uint64_t(bucket.blocksCount) * sizeof(uint64_t);
+        if(blocksCount != bucket.blocksCount ||
+           bucket.blocksOffset > m_size || blocksSize > m_size - bucket.blocksOffset ||
+           bucket.blocksOffset % sizeof(uint64_t) != 0)
+        {
+            return false;
+        }
+
+        auto blockOffsets = reinterpret_cast<const uint64_t *>(m_data + bucket.blocksOffset);
+        for(uint32_t j = 0; j < bucket.blocksCount; ++j)
+        {
+            //The last block can be partial.
+            auto count = (j + 1 == bucket.blocksCount)
+                         ? bucket.puzzlesCount - uint64_t(j) * bucket.blockPuzzlesCount
+                         : uint64_t(bucket.blockPuzzlesCount);
+
+            if(blockOffsets[j] < sizeof(PuzzleBank::FileHeader) ||
+               blockOffsets[j] > header->indexOffset            ||
+               count * bucket.puzzleSize > header->indexOffset - blockOffsets[j])
+            {
+                return false;
+            }
+        }
+
+        //Must be sorted for the lookups.
+        if(i > 0 && !(getKey(buckets[i - 1]) < getKey(bucket)))
+            return false;
+    }
+
+    m_header  = header;
+    m_buckets = buckets;
+
+    return true;
+}
+
+const PuzzleBank::FileBucket* PuzzleBankReader::findBucket(int width,
+                                                           int height,
+                                                           int difficulty) const
+{
+    if(!isOpen())
+        return nullptr;
+
+    auto key   = std::make_tuple(width, height, difficulty);
+    auto begin = m_buckets;
+    auto end   = m_buckets + m_header->bucketsCount;
+
+    auto it = std::lower_bound(
+        begin, end, key,
+        [](const PuzzleBank::FileBucket &bucket, const std::tuple<int, int, int> &key) {
+            return getKey(bucket) < key;
+        }
+    );
+
+    if(it == end || getKey(*it) != key)
+        return nullptr;
+
+    return it;
+}
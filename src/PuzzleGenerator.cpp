@@ -0,0 +1,191 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        PuzzleGenerator.cpp                       //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/PuzzleGenerator.h"
+//std
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <thread>
+#include <vector>
+//CorePuzzle15
+#include "../include/BoardGenerator.h"
+#include "../include/Heuristics.h"
+//CoreRandom
+#include "CoreRandom.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int PuzzleGenerator::kRoundPuzzlesCount;
+const int PuzzleGenerator::kChunkPuzzlesCount;
+
+
+// Public Methods //
+PuzzleGenerator::Stats PuzzleGenerator::generate(const Options &options,
+                                                 const Callback &callback)
+{
+    Stats stats;
+
+    if(options.width < 1 || options.height < 1 || options.firstSeed < 0 ||
+       options.count > uint64_t(INT_MAX) - options.firstSeed + 1)
+    {
+        return stats;
+    }
+
+    auto threadsCount = options.threadsCount;
+    if(threadsCount <= 0)
+        threadsCount = std::max(1u, std::thread::hardware_concurrency());
+
+    //Each thread keeps it's own Solver through all rounds.
+    std::unique_ptr<Solver[]> solvers(new Solver[threadsCount]);
+    for(int i = 0; i < threadsCount; ++i)
+    {
+        solvers[i].setMaxExpandedNodes(options.maxExpandedNodes);
+        solvers[i].setPatternDatabase (options.database);
+    }
+
+    std::vector<PuzzleBank::Puzzle> puzzles(kRoundPuzzlesCount);
+    for(auto &puzzle : puzzles)
+        puzzle.board.resize(options.width, options.height);
+
+    for(uint64_t first = 0; first < options.count; first += kRoundPuzzlesCount)
+    {
+        auto roundCount = static_cast<size_t>(
+            std::min<uint64_t>(kRoundPuzzlesCount, options.count - first)
+        );
+
+        std::atomic<size_t> next(0);
+        auto work = [&](int threadIndex) {
+            while(true)
+            {
+                auto begin = next.fetch_add(kChunkPuzzlesCount);
+                if(begin >= roundCount)
+                    break;
+
+                auto end = std::min(roundCount, begin + kChunkPuzzlesCount);
+                for(auto i = begin; i < end; ++i)
+                {
+                    auto &puzzle = puzzles[i];
+                    puzzle.seed  = static_cast<int>(options.firstSeed + first + i);
+
+                    if(options.source == Source::Series)
+                        makeSeriesBoard(options.seriesSeed, puzzle.seed, puzzle.board);
+                    else
+                        makeBoard(puzzle.seed, puzzle.board);
+
+                    puzzle.difficulty = rate(puzzle.board,
+                                             options.rating,
+                                             solvers[threadIndex]);
+                }
+            }
+        };
+
+        //The calling thread works too.
+        std::vector<std::thread> threads;
+        for(int i = 1; i < threadsCount; ++i)
+            threads.emplace_back(work, i);
+
+        work(0);
+        for(auto &thread : threads)
+            thread.join();
+
+        for(size_t i = 0; i < roundCount; ++i)
+        {
+            if(puzzles[i].difficulty < 0)
+            {
+                ++stats.skippedCount;
+                continue;
+            }
+
+            ++stats.generatedCount;
+            if(!callback(puzzles[i]))
+                return stats;
+        }
+    }
+
+    return stats;
+}
+
+PuzzleGenerator::Stats PuzzleGenerator::generate(const Options &options,
+                                                 PuzzleBank &bank)
+{
+    if(!bank.setSource(options.source, options.seriesSeed))
+        return Stats();
+
+    return generate(options, [&bank](const PuzzleBank::Puzzle &puzzle) {
+        return bank.add(puzzle);
+    });
+}
+
+
+void PuzzleGenerator::makeBoard(int seed, FlatBoard &board)
+{
+    //Same steps of the GameCore CTOR.
+    CoreRandom::Random random(seed);
+    BoardGenerator::generate(board, random.getNumberGenerator());
+}
+
+void PuzzleGenerator::makeSeriesBoard(uint64_t seriesSeed,
+                                      uint64_t index,
+                                      FlatBoard &board)
+{
+    BoardGenerator::generateSeries(board, BoardGenerator::Series(seriesSeed, index));
+}
+
+int PuzzleGenerator::rate(const FlatBoard &board, Rating rating,
+                          Solver &solver)
+{
+    if(rating == Rating::Heuristic)
+    {
+        return Heuristics::manhattanDistance(board)
+             + Heuristics::linearConflict   (board);
+    }
+
+    auto result = solver.solve(board);
+    if(result.status != Solver::Result::Status::Solved)
+        return -1;
+
+    return static_cast<int>(result.moves.size());
+}
@@ -0,0 +1,624 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        ReductionSolver.cpp                       //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/ReductionSolver.h"
+//std
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+//CorePuzzle15
+#include "../include/BoardGenerator.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+namespace {
+
+//The last two tiles of a line are placed by a search over the
+//window cells - (window cells)^3 states.
+const int kMaxWindowLines = 16;
+
+//The Board left is solved by the Solver from this size down.
+const int kRestSize = 3;
+
+} //namespace
+
+
+// CTOR/DTOR //
+ReductionSolver::ReductionSolver() :
+    m_deadline  (Clock::time_point::max()),
+    m_width     (0),
+    m_height    (0),
+    m_top       (0),
+    m_left      (0),
+    m_emptyIndex(0),
+    m_visitStamp(0)
+{
+    //Empty...
+}
+
+
+// Public Methods //
+ReductionSolver::Result ReductionSolver::solve(const GameCore &core)
+{
+    return solve(core.getFlatBoard());
+}
+
+ReductionSolver::Result ReductionSolver::solve(const FlatBoard &board)
+{
+    Result result;
+
+    if(!BoardGenerator::isSolvable(board))
+    {
+        result.status = Result::Status::Unsolvable;
+        return result;
+    }
+
+    //A single line has nothing to reduce.
+    if(board.getWidth() < 2 || board.getHeight() < 2)
+    {
+        if(board.getCellsCount() > Solver::kMaxCellsCount)
+            return result;
+
+        m_solver.setDeadline(m_deadline);
+        auto solved = m_solver.solve(board);
+
+        if(solved.status == Solver::Result::Status::Solved)
+        {
+            result.status = Result::Status::Solved;
+            result.moves  = std::move(solved.moves);
+        }
+        else if(solved.status == Solver::Result::Status::Timeout)
+        {
+            result.status = Result::Status::Timeout;
+        }
+        return result;
+    }
+
+    m_width  = board.getWidth ();
+    m_height = board.getHeight();
+    m_top    = 0;
+    m_left   = 0;
+
+    auto count = board.getCellsCount();
+    m_cells    .resize(count);
+    m_positions.resize(count);
+    m_fixed    .assign(count, 0);
+    m_parents  .resize(count);
+    m_visits   .assign(count, 0);
+    m_visitStamp = 0;
+    m_path.clear();
+
+    for(int i = 0; i < count; ++i)
+    {
+        m_cells[i] = board.getValueAt(i);
+        m_positions[m_cells[i]] = i;
+    }
+    m_emptyIndex = m_positions[0];
+
+    //Take out the longer side each time, so the Board left stays square.
+    auto solved = true;
+    while(solved &&
+          (m_height - m_top > kRestSize || m_width - m_left > kRestSize))
+    {
+        solved = solveLine(m_width - m_left > m_height - m_top);
+    }
+
+    if(solved)
+        solved = solveRest();
+
+    if(!solved)
+    {
+        result.status = isTimeout() ? Result::Status::Timeout
+                                    : Result::Status::Unsupported;
+        return result;
+    }
+
+    result.status = Result::Status::Solved;
+    result.moves.reserve(m_path.size());
+    for(auto index : m_path)
+        result.moves.push_back(board.getCoord(index));
+
+    return result;
+}
+
+
+void ReductionSolver::setDeadline(const Clock::time_point &deadline)
+{
+    m_deadline = deadline;
+}
+
+const ReductionSolver::Clock::time_point& ReductionSolver::getDeadline() const
+{
+    return m_deadline;
+}
+
+
+// Private Methods //
+bool ReductionSolver::solveLine(bool isCol)
+{
+    auto line  = isCol ? m_left       : m_top;
+    auto start = isCol ? m_top        : m_left;
+    auto end   = isCol ? m_height - 1 : m_width - 1;
+
+    //All but the last two tiles go straight to their goals.
+    for(auto position = start; position < end - 1; ++position)
+    {
+        if(isTimeout())
+            return false;
+
+        auto target = getCell(line, position, isCol);
+        if(!moveTile(target + 1, target))
+            return false;
+
+        m_fixed[target] = 1;
+    }
+
+    if(isTimeout() || !solveLineEnd(line, end, start, isCol))
+        return false;
+
+    if(isCol)
+        ++m_left;
+    else
+        ++m_top;
+
+    return true;
+}
+
+bool ReductionSolver::solveLineEnd(int line, int end, int start, bool isCol)
+{
+    auto targetA = getCell(line, end - 1, isCol);
+    auto targetB = getCell(line, end,     isCol);
+    auto valueA  = targetA + 1;
+    auto valueB  = targetB + 1;
+
+    if(m_positions[valueA] != targetA || m_positions[valueB] != targetB)
+    {
+        //Bring both two lines below their goals, B first - A is pushed
+        //around B, unless that walls the empty tile off (a two cells
+        //wide Board), then B may be pushed a bit too.
+        auto stagingB = getCell(line + 2, end,     isCol);
+        auto stagingA = getCell(line + 2, end - 1, isCol);
+
+        if(!moveTile(valueB, stagingB))
+            return false;
+
+        m_fixed[stagingB] = 1;
+        auto staged = moveTile(valueA, stagingA);
+        m_fixed[stagingB] = 0;
+
+        if(!staged && !moveTile(valueA, stagingA))
+            return false;
+
+        //The window must have both tiles.
+        auto getLine = [this, isCol](int index) {
+            return isCol ? index % m_width : index / m_width;
+        };
+        auto lines = std::max(getLine(m_positions[valueA]),
+                              getLine(m_positions[valueB])) - line + 1;
+        auto maxLines = (isCol ? m_width : m_height) - line;
+
+        auto placed = false;
+        for(lines = std::max(lines, 3);
+            !placed && lines <= std::min(maxLines, kMaxWindowLines);
+            ++lines)
+        {
+            placed = placePair(valueA, targetA, valueB, targetB,
+                               lines, line, end, start, isCol);
+        }
+
+        if(!placed)
+            return false;
+    }
+
+    m_fixed[targetA] = 1;
+    m_fixed[targetB] = 1;
+
+    return true;
+}
+
+bool ReductionSolver::solveRest()
+{
+    auto width  = m_width  - m_left;
+    auto height = m_height - m_top;
+
+    //The tiles left are the ones which goals are left, so
+    //they're renumbered as a Board of it's own.
+    FlatBoard rest;
+    rest.resize(width, height);
+
+    for(int i = 0; i < height; ++i)
+    {
+        for(int j = 0; j < width; ++j)
+        {
+            auto value = m_cells[(m_top + i) * m_width + m_left + j];
+            if(value != 0)
+            {
+                auto goal = value - 1;
+                value = (goal / m_width - m_top) * width
+                      + (goal % m_width - m_left) + 1;
+            }
+            rest.setValueAt(i * width + j, value);
+        }
+    }
+
+    m_solver.setDeadline(m_deadline);
+    auto result = m_solver.solve(rest);
+    if(result.status != Solver::Result::Status::Solved)
+        return false;
+
+    for(const auto &coord : result.moves)
+        slide((m_top + coord.y) * m_width + m_left + coord.x);
+
+    return true;
+}
+
+
+bool ReductionSolver::moveTile(int value, int target)
+{
+    auto targetRow = target / m_width;
+    auto targetCol = target % m_width;
+
+    //Each step takes the tile a cell closer - The empty tile goes
+    //around it to the cell, then they swap.
+    while(m_positions[value] != target)
+    {
+        auto index = m_positions[value];
+        auto row   = index / m_width;
+        auto col   = index % m_width;
+
+        int candidates[2];
+        int candidatesCount = 0;
+
+        if(row != targetRow)
+            candidates[candidatesCount++] = index + ((row < targetRow) ? m_width : -m_width);
+        if(col != targetCol)
+            candidates[candidatesCount++] = index + ((col < targetCol) ? 1 : -1);
+
+        //The one nearer to the empty tile first.
+        auto getDistance = [this](int cell) {
+            return std::abs(cell / m_width - m_emptyIndex / m_width)
+                 + std::abs(cell % m_width - m_emptyIndex % m_width);
+        };
+        if(candidatesCount == 2 &&
+           getDistance(candidates[1]) < getDistance(candidates[0]))
+        {
+            std::swap(candidates[0], candidates[1]);
+        }
+
+        auto moved = false;
+        m_fixed[index] = 1;
+        for(int i = 0; i < candidatesCount && !moved; ++i)
+            moved = isFree(candidates[i]) && moveEmpty(candidates[i]);
+        m_fixed[index] = 0;
+
+        if(!moved)
+            return false;
+
+        slide(index);
+    }
+
+    return true;
+}
+
+bool ReductionSolver::moveEmpty(int target)
+{
+    if(m_emptyIndex == target)
+        return true;
+
+    return moveEmptyStraight(target, true )
+        || moveEmptyStraight(target, false)
+        || moveEmptySearch  (target, 1    )
+        || moveEmptySearch  (target, -1   );
+}
+
+bool ReductionSolver::moveEmptyStraight(int target, bool rowFirst)
+{
+    auto targetRow = target / m_width;
+    auto targetCol = target % m_width;
+
+    //First pass checks that all cells are free, second one moves.
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        auto row = m_emptyIndex / m_width;
+        auto col = m_emptyIndex % m_width;
+
+        for(int leg = 0; leg < 2; ++leg)
+        {
+            auto alongRow = ((leg == 0) == rowFirst);
+            while(alongRow ? col != targetCol : row != targetRow)
+            {
+                if(alongRow)
+                    col += (col < targetCol) ? 1 : -1;
+                else
+                    row += (row < targetRow) ? 1 : -1;
+
+                auto index = row * m_width + col;
+                if(pass == 0 && !isFree(index))
+                    return false;
+                if(pass == 1)
+                    slide(index);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ReductionSolver::moveEmptySearch(int target, int margin)
+{
+    //BFS inside of the box around both ends (or all the Board left).
+    auto minRow = m_top,        maxRow = m_height - 1;
+    auto minCol = m_left,       maxCol = m_width  - 1;
+
+    if(margin >= 0)
+    {
+        auto emptyRow = m_emptyIndex / m_width, targetRow = target / m_width;
+        auto emptyCol = m_emptyIndex % m_width, targetCol = target % m_width;
+
+        minRow = std::max(minRow, std::min(emptyRow, targetRow) - margin);
+        maxRow = std::min(maxRow, std::max(emptyRow, targetRow) + margin);
+        minCol = std::max(minCol, std::min(emptyCol, targetCol) - margin);
+        maxCol = std::min(maxCol, std::max(emptyCol, targetCol) + margin);
+    }
+
+    if(++m_visitStamp == 0)
+    {
+        std::fill(m_visits.begin(), m_visits.end(), 0);
+        m_visitStamp = 1;
+    }
+
+    m_queue.clear();
+    m_queue.push_back(m_emptyIndex);
+    m_visits [m_emptyIndex] = m_visitStamp;
+    m_parents[m_emptyIndex] = -1;
+
+    auto found = false;
+    for(size_t i = 0; i < m_queue.size() && !found; ++i)
+    {
+        auto index = m_queue[i];
+        auto row   = index / m_width;
+        auto col   = index % m_width;
+
+        const int neighbors[4][2] = {
+            { row - 1, col }, { row + 1, col }, { row, col - 1 }, { row, col + 1 }
+        };
+        for(const auto &neighbor : neighbors)
+        {
+            if(neighbor[0] < minRow || neighbor[0] > maxRow ||
+               neighbor[1] < minCol || neighbor[1] > maxCol)
+            {
+                continue;
+            }
+
+            auto next = neighbor[0] * m_width + neighbor[1];
+            if(m_visits[next] == m_visitStamp || m_fixed[next])
+                continue;
+
+            m_visits [next] = m_visitStamp;
+            m_parents[next] = index;
+            m_queue.push_back(next);
+
+            if(next == target)
+            {
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if(!found)
+        return false;
+
+    //The path comes backwards from target.
+    m_queue.clear();
+    for(auto index = target; index != m_emptyIndex; index = m_parents[index])
+        m_queue.push_back(index);
+
+    for(auto it = m_queue.rbegin(); it != m_queue.rend(); ++it)
+        slide(*it);
+
+    return true;
+}
+
+bool ReductionSolver::placePair(int valueA, int targetA, int valueB, int targetB,
+                                int lines, int line, int end, int start,
+                                bool isCol)
+{
+    //The free cells of the window - The last three
+    //positions of the first lines of the Board left.
+    std::vector<int> cells;
+    for(int i = line; i < line + lines; ++i)
+    {
+        for(int j = std::max(start, end - 2); j <= end; ++j)
+        {
+            auto index = getCell(i, j, isCol);
+            if(!m_fixed[index])
+                cells.push_back(index);
+        }
+    }
+
+    auto count   = static_cast<int>(cells.size());
+    auto getSlot = [&cells](int index) {
+        auto it = std::find(cells.begin(), cells.end(), index);
+        return (it == cells.end()) ? -1 : static_cast<int>(it - cells.begin());
+    };
+
+    auto slotA = getSlot(m_positions[valueA]);
+    auto slotB = getSlot(m_positions[valueB]);
+    if(slotA == -1 || slotB == -1)
+        return false;
+
+    //Bring the empty tile in, around A and B.
+    auto emptySlot = getSlot(m_emptyIndex);
+    if(emptySlot == -1)
+    {
+        auto nearest  = -1;
+        auto distance = 0;
+        for(int i = 0; i < count; ++i)
+        {
+            if(i == slotA || i == slotB)
+                continue;
+
+            auto d = std::abs(cells[i] / m_width - m_emptyIndex / m_width)
+                   + std::abs(cells[i] % m_width - m_emptyIndex % m_width);
+            if(nearest == -1 || d < distance)
+            {
+                nearest  = i;
+                distance = d;
+            }
+        }
+
+        if(nearest == -1)
+            return false;
+
+        m_fixed[cells[slotA]] = 1;
+        m_fixed[cells[slotB]] = 1;
+        auto moved = moveEmpty(cells[nearest]);
+        m_fixed[cells[slotA]] = 0;
+        m_fixed[cells[slotB]] = 0;
+
+        if(!moved)
+            return false;
+
+        emptySlot = nearest;
+    }
+
+    std::vector<std::vector<int>> neighbors(count);
+    for(int i = 0; i < count; ++i)
+    {
+        for(int j = 0; j < count; ++j)
+        {
+            auto d = std::abs(cells[i] / m_width - cells[j] / m_width)
+                   + std::abs(cells[i] % m_width - cells[j] % m_width);
+            if(d == 1)
+                neighbors[i].push_back(j);
+        }
+    }
+
+    //BFS over (A slot, B slot, empty slot) - The other tiles are alike.
+    auto getState = [count](int a, int b, int e) {
+        return (a * count + b) * count + e;
+    };
+
+    auto goalA = getSlot(targetA);
+    auto goalB = getSlot(targetB);
+
+    std::vector<int> parents(count * count * count, -2);
+    std::vector<int> queue(1, getState(slotA, slotB, emptySlot));
+    parents[queue[0]] = -1;
+
+    auto goal = -1;
+    for(size_t i = 0; i < queue.size() && goal == -1; ++i)
+    {
+        auto state = queue[i];
+        auto e     = state % count;
+        auto b     = (state / count) % count;
+        auto a     = state / (count * count);
+
+        if(a == goalA && b == goalB)
+        {
+            goal = state;
+            break;
+        }
+
+        for(auto next : neighbors[e])
+        {
+            //The tile at next slides into e.
+            auto nextA = (next == a) ? e : a;
+            auto nextB = (next == b) ? e : b;
+
+            auto nextState = getState(nextA, nextB, next);
+            if(parents[nextState] != -2)
+                continue;
+
+            parents[nextState] = state;
+            queue.push_back(nextState);
+        }
+    }
+
+    if(goal == -1)
+        return false;
+
+    queue.clear();
+    for(auto state = goal; parents[state] != -1; state = parents[state])
+        queue.push_back(cells[state % count]);
+
+    for(auto it = queue.rbegin(); it != queue.rend(); ++it)
+        slide(*it);
+
+    return true;
+}
+
+
+void ReductionSolver::slide(int index)
+{
+    auto value = m_cells[index];
+
+    m_cells[m_emptyIndex] = value;
+    m_positions[value]    = m_emptyIndex;
+    m_cells[index]        = 0;
+    m_positions[0]        = index;
+    m_emptyIndex          = index;
+
+    m_path.push_back(index);
+}
+
+
+int ReductionSolver::getCell(int line, int position, bool isCol) const
+{
+    return isCol ? position * m_width + line
+                 : line * m_width + position;
+}
+
+bool ReductionSolver::isFree(int index) const
+{
+    return index / m_width >= m_top  &&
+           index % m_width >= m_left &&
+           !m_fixed[index];
+}
+
+bool ReductionSolver::isTimeout()
+{
+    return m_deadline != Clock::time_point::max() && Clock::now() >= m_deadline;
+}
@@ -0,0 +1,430 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        SessionManager.cpp                        //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/SessionManager.h"
+//std
+#include <algorithm>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const SessionManager::SessionId SessionManager::kInvalidSessionId;
+const int SessionManager::kMaxShardsCount;
+const int SessionManager::kMaxSessionsPerShard;
+
+namespace {
+
+//SessionId = generation (32 bits) | slot (24 bits) | shard (8 bits).
+const int kShardBits = 8;
+const int kSlotBits  = 24;
+
+inline SessionManager::SessionId makeId(uint32_t shard,
+                                        uint32_t slot,
+                                        uint32_t generation)
+{
+    return (static_cast<uint64_t>(generation) << (kShardBits + kSlotBits)) |
+           (static_cast<uint64_t>(slot)       << kShardBits)                |
+           shard;
+}
+
+inline uint32_t getShardIndex(SessionManager::SessionId id)
+{
+    return static_cast<uint32_t>(id & ((1u << kShardBits) - 1));
+}
+
+inline uint32_t getSlotIndex(SessionManager::SessionId id)
+{
+    return static_cast<uint32_t>((id >> kShardBits) & ((1u << kSlotBits) - 1));
+}
+
+inline uint32_t getGeneration(SessionManager::SessionId id)
+{
+    return static_cast<uint32_t>(id >> (kShardBits + kSlotBits));
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+SessionManager::SessionManager(const Options &options) :
+    m_options      (options),
+    m_nextShard    (0),
+    m_sessionsCount(0)
+{
+    m_options.shardsCount      = std::min(std::max(1, m_options.shardsCount),
+                                          kMaxShardsCount);
+    m_options.sessionsPerShard = std::min(std::max(1, m_options.sessionsPerShard),
+                                          kMaxSessionsPerShard);
+    m_options.maxCellsCount    = std::max(1, m_options.maxCellsCount);
+
+    auto slotsCount = static_cast<size_t>(m_options.sessionsPerShard);
+
+    //Cells of each slot start at a cache line too.
+    const size_t kCellsPerLine = COREPUZZLE15_CACHE_LINE_SIZE / sizeof(uint32_t);
+    auto cellsStride = static_cast<size_t>(m_options.maxCellsCount);
+    cellsStride = (cellsStride + kCellsPerLine - 1) / kCellsPerLine * kCellsPerLine;
+
+    m_shards.reset(new Shard[m_options.shardsCount]);
+    for(int i = 0; i < m_options.shardsCount; ++i)
+    {
+        auto &shard = m_shards[i];
+        shard.slots.reset(slotsCount);
+        shard.cells.reset(slotsCount * cellsStride);
+
+        //Taken from the back - The first slots go first.
+        shard.freeSlots.reserve(slotsCount);
+        for(auto j = slotsCount; j > 0; --j)
+            shard.freeSlots.push_back(static_cast<uint32_t>(j - 1));
+
+        for(size_t j = 0; j < slotsCount; ++j)
+        {
+            auto &slot = shard.slots[j];
+            slot.generation.store(0);
+            slot.sequence  .store(0);
+            slot.width     .store(0);
+            slot.height    .store(0);
+            slot.status    .store(static_cast<int32_t>(CoreGame::Status::Continue));
+            slot.movesCount.store(0);
+            slot.cells = shard.cells.get() + j * cellsStride;
+        }
+    }
+}
+
+SessionManager::~SessionManager()
+{
+    //Empty...
+}
+
+
+// Public Methods //
+SessionManager::SessionId SessionManager::create(int width, int height,
+                                                 int maxMoves, int seed)
+{
+    if(width <= 0 || height <= 0 || width * height > m_options.maxCellsCount)
+        return kInvalidSessionId;
+
+    //Round robin, so the shards (and their mutexes) share the load.
+    auto first      = m_nextShard.fetch_add(1, std::memory_order_relaxed);
+    auto shardIndex = uint32_t(0);
+    auto slotIndex  = uint32_t(0);
+    auto found      = false;
+
+    for(int i = 0; i < m_options.shardsCount && !found; ++i)
+    {
+        shardIndex  = (first + i) % m_options.shardsCount;
+        auto &shard = m_shards[shardIndex];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if(shard.freeSlots.empty())
+            continue;
+
+        slotIndex = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+        found = true;
+    }
+
+    if(!found)
+        return kInvalidSessionId;
+
+    auto &slot = m_shards[shardIndex].slots[slotIndex];
+    std::lock_guard<std::mutex> lock(slot.mutex);
+
+    if(slot.core)
+        slot.core->reset(width, height, maxMoves, seed);
+    else
+        slot.core.reset(new GameCore(width, height, maxMoves, seed));
+
+    publishBoard(slot);
+    publishState(slot);
+
+    //Odd - Alive. Readers that see it see the Board too.
+    auto generation = slot.generation.fetch_add(1, std::memory_order_release) + 1;
+    m_sessionsCount.fetch_add(1, std::memory_order_relaxed);
+
+    return makeId(shardIndex, slotIndex, generation);
+}
+
+bool SessionManager::destroy(SessionId id)
+{
+    auto slot = findSlot(id);
+    if(!slot)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if(!isAlive(*slot, id))
+            return false;
+
+        //Even - Dead. The id never matches again.
+        slot->generation.fetch_add(1, std::memory_order_release);
+    }
+
+    auto &shard = m_shards[getShardIndex(id)];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.freeSlots.push_back(getSlotIndex(id));
+    }
+
+    m_sessionsCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+
+bool SessionManager::move(SessionId id,
+                          const CoreCoord::Coord &coord,
+                          GameCore::MoveSummary &summary)
+{
+    auto slot = findSlot(id);
+    if(!slot)
+        return false;
+
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    if(!isAlive(*slot, id))
+        return false;
+
+    auto &core      = *slot->core;
+    auto  fromIndex = core.getFlatBoard().getIndex(core.getEmptyValueCoord());
+
+    summary = core.moveFast(coord);
+    if(summary.tilesCount != 0)
+    {
+        publish(*slot, fromIndex,
+                core.getFlatBoard().getIndex(core.getEmptyValueCoord()));
+    }
+
+    return true;
+}
+
+bool SessionManager::undo(SessionId id, GameCore::MoveSummary &summary)
+{
+    auto slot = findSlot(id);
+    if(!slot)
+        return false;
+
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    if(!isAlive(*slot, id))
+        return false;
+
+    auto &core      = *slot->core;
+    auto  fromIndex = core.getFlatBoard().getIndex(core.getEmptyValueCoord());
+
+    summary = core.undo();
+    if(summary.tilesCount != 0)
+    {
+        publish(*slot, fromIndex,
+                core.getFlatBoard().getIndex(core.getEmptyValueCoord()));
+    }
+
+    return true;
+}
+
+
+bool SessionManager::getStatus(SessionId id, CoreGame::Status &status) const
+{
+    auto slot = findSlot(id);
+    if(!slot || !isAlive(*slot, id))
+        return false;
+
+    auto value = slot->status.load(std::memory_order_acquire);
+
+    //Destroyed (and maybe reused) in the middle.
+    if(!isAlive(*slot, id))
+        return false;
+
+    status = static_cast<CoreGame::Status>(value);
+    return true;
+}
+
+bool SessionManager::getMovesCount(SessionId id, int &movesCount) const
+{
+    auto slot = findSlot(id);
+    if(!slot || !isAlive(*slot, id))
+        return false;
+
+    auto value = slot->movesCount.load(std::memory_order_acquire);
+
+    //Destroyed (and maybe reused) in the middle.
+    if(!isAlive(*slot, id))
+        return false;
+
+    movesCount = value;
+    return true;
+}
+
+bool SessionManager::getBoard(SessionId id, FlatBoard &board) const
+{
+    auto slot = findSlot(id);
+    if(!slot)
+        return false;
+
+    for(;;)
+    {
+        if(!isAlive(*slot, id))
+            return false;
+
+        auto sequence = slot->sequence.load(std::memory_order_acquire);
+        if(sequence & 1)
+            continue; //A move is being published.
+
+        auto width  = slot->width .load(std::memory_order_relaxed);
+        auto height = slot->height.load(std::memory_order_relaxed);
+
+        //Torn by a create() of a reused slot - The check below fails.
+        if(width > 0 && height > 0 &&
+           width * height <= m_options.maxCellsCount)
+        {
+            if(board.getWidth() != width || board.getHeight() != height)
+                board.resize(width, height);
+
+            for(int i = 0; i < width * height; ++i)
+            {
+                board.setValueAt(
+                    i,
+                    static_cast<int>(slot->cells[i].load(std::memory_order_relaxed))
+                );
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot->sequence.load(std::memory_order_relaxed) == sequence)
+            return isAlive(*slot, id);
+    }
+}
+
+
+bool SessionManager::isValid(SessionId id) const
+{
+    auto slot = findSlot(id);
+    return slot && isAlive(*slot, id);
+}
+
+size_t SessionManager::getSessionsCount() const
+{
+    return m_sessionsCount.load(std::memory_order_relaxed);
+}
+
+const SessionManager::Options& SessionManager::getOptions() const
+{
+    return m_options;
+}
+
+
+// Private Methods //
+SessionManager::Slot* SessionManager::findSlot(SessionId id)
+{
+    auto shardIndex = getShardIndex(id);
+    auto slotIndex  = getSlotIndex (id);
+
+    if(shardIndex >= static_cast<uint32_t>(m_options.shardsCount) ||
+       slotIndex  >= static_cast<uint32_t>(m_options.sessionsPerShard))
+    {
+        return nullptr;
+    }
+
+    return &m_shards[shardIndex].slots[slotIndex];
+}
+
+const SessionManager::Slot* SessionManager::findSlot(SessionId id) const
+{
+    return const_cast<SessionManager *>(this)->findSlot(id);
+}
+
+bool SessionManager::isAlive(const Slot &slot, SessionId id) const
+{
+    auto generation = getGeneration(id);
+    return (generation & 1) &&
+           slot.generation.load(std::memory_order_acquire) == generation;
+}
+
+//The move changed the cells from the old empty
+//index to the new one - A row or a column segment.
+void SessionManager::publish(Slot &slot, int fromIndex, int toIndex)
+{
+    const auto &board = slot.core->getFlatBoard();
+    auto width = board.getWidth();
+
+    auto step  = (fromIndex / width == toIndex / width) ? 1 : width;
+    auto first = std::min(fromIndex, toIndex);
+    auto last  = std::max(fromIndex, toIndex);
+
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for(int i = first; i <= last; i += step)
+    {
+        slot.cells[i].store(static_cast<uint32_t>(board.getValueAt(i)),
+                            std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    publishState(slot);
+}
+
+void SessionManager::publishBoard(Slot &slot)
+{
+    const auto &board = slot.core->getFlatBoard();
+
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.width .store(board.getWidth (), std::memory_order_relaxed);
+    slot.height.store(board.getHeight(), std::memory_order_relaxed);
+    for(int i = 0; i < board.getCellsCount(); ++i)
+    {
+        slot.cells[i].store(static_cast<uint32_t>(board.getValueAt(i)),
+                            std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SessionManager::publishState(Slot &slot)
+{
+    const auto &core = *slot.core;
+
+    slot.movesCount.store(core.getMovesCount(), std::memory_order_release);
+    slot.status    .store(static_cast<int32_t>(core.getStatus()),
+                          std::memory_order_release);
+}
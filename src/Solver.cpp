@@ -0,0 +1,464 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        Solver.cpp                                //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/Solver.h"
+//std
+#include <algorithm>
+#include <climits>
+//CorePuzzle15
+#include "../include/BoardGenerator.h"
+#include "../include/Heuristics.h"
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const uint64_t Solver::kUnlimitedNodes = UINT64_MAX;
+
+
+// CTOR/DTOR //
+Solver::Solver() :
+    m_maxExpandedNodes(kUnlimitedNodes),
+    m_expandedNodes   (0),
+    m_deadline        (Clock::time_point::max()),
+    m_stop            (nullptr),
+    m_abortStatus     (Result::Status::NodeLimit),
+    m_width           (0),
+    m_height          (0),
+    m_cellsCount      (0),
+    m_emptyIndex      (0),
+    m_manhattan       (0),
+    m_conflict        (0),
+    m_database        (nullptr),
+    m_usingDatabase   (false),
+    m_patternsExtra   (0),
+    m_bound           (0),
+    m_nextBound       (0),
+    m_aborted         (false)
+{
+    //Empty...
+}
+
+
+// Public Methods //
+Solver::Result Solver::solve(const GameCore &core)
+{
+    return solve(core.getFlatBoard());
+}
+
+Solver::Result Solver::solve(const FlatBoard &board)
+{
+    Result result;
+
+    if(board.getCellsCount() > kMaxCellsCount)
+        return result;
+
+    if(!BoardGenerator::isSolvable(board))
+    {
+        result.status = Result::Status::Unsolvable;
+        return result;
+    }
+
+    initTables(board);
+
+    //IDA* - Deepen the bound to the smallest f that went past it.
+    m_expandedNodes = 0;
+    m_aborted       = false;
+    m_bound         = getHeuristic();
+    m_path.clear();
+
+    while(true)
+    {
+        m_nextBound = INT_MAX;
+        if(search(0, -1))
+        {
+            result.status = Result::Status::Solved;
+            break;
+        }
+
+        if(m_aborted)
+        {
+            result.status = m_abortStatus;
+            break;
+        }
+
+        m_bound = m_nextBound;
+    }
+
+    result.expandedNodes = m_expandedNodes;
+
+    result.moves.reserve(m_path.size());
+    for(auto index : m_path)
+        result.moves.push_back(board.getCoord(index));
+
+    return result;
+}
+
+
+void Solver::setMaxExpandedNodes(uint64_t maxNodes)
+{
+    m_maxExpandedNodes = maxNodes;
+}
+
+uint64_t Solver::getMaxExpandedNodes() const
+{
+    return m_maxExpandedNodes;
+}
+
+
+void Solver::setDeadline(const Clock::time_point &deadline)
+{
+    m_deadline = deadline;
+}
+
+const Solver::Clock::time_point& Solver::getDeadline() const
+{
+    return m_deadline;
+}
+
+
+void Solver::setPatternDatabase(const PatternDatabase *database)
+{
+    m_database = database;
+}
+
+
+// Private Methods //
+void Solver::initTables(const FlatBoard &board)
+{
+    m_width      = board.getWidth();
+    m_height     = board.getHeight();
+    m_cellsCount = board.getCellsCount();
+
+    for(int i = 0; i < m_cellsCount; ++i)
+    {
+        //Distances.
+        for(int value = 0; value < m_cellsCount; ++value)
+        {
+            m_distances[value][i] = static_cast<uint8_t>(
+                Heuristics::getTileDistance(value, i, m_width, m_cellsCount)
+            );
+        }
+
+        //Neighbors.
+        auto row = i / m_width;
+        auto col = i % m_width;
+
+        m_rows[i] = static_cast<int8_t>(row);
+        m_cols[i] = static_cast<int8_t>(col);
+
+        m_neighborsCount[i] = 0;
+        if(row > 0          ) m_neighbors[i][m_neighborsCount[i]++] = i - m_width;
+        if(row < m_height -1) m_neighbors[i][m_neighborsCount[i]++] = i + m_width;
+        if(col > 0          ) m_neighbors[i][m_neighborsCount[i]++] = i - 1;
+        if(col < m_width  -1) m_neighbors[i][m_neighborsCount[i]++] = i + 1;
+
+        //Cells.
+        m_cells[i] = static_cast<uint8_t>(board.getValueAt(i));
+        if(m_cells[i] == 0)
+            m_emptyIndex = i;
+    }
+
+    //Heuristic.
+    m_manhattan = 0;
+    for(int i = 0; i < m_cellsCount; ++i)
+        m_manhattan += m_distances[m_cells[i]][i];
+
+    m_conflict = 0;
+    for(int i = 0; i < m_height; ++i)
+    {
+        m_rowConflicts[i] = rowConflict(i);
+        m_conflict       += m_rowConflicts[i];
+    }
+    for(int j = 0; j < m_width; ++j)
+    {
+        m_colConflicts[j] = colConflict(j);
+        m_conflict       += m_colConflicts[j];
+    }
+
+    //Pattern database.
+    m_usingDatabase = m_database                             &&
+                      m_database->isLoaded()                 &&
+                      m_database->getWidth () == m_width     &&
+                      m_database->getHeight() == m_height;
+    m_patternsExtra = 0;
+
+    if(!m_usingDatabase)
+        return;
+
+    for(int i = 0; i < m_cellsCount; ++i)
+    {
+        m_patternOf[i]          = -1;
+        m_positions[m_cells[i]] = static_cast<uint8_t>(i);
+    }
+
+    for(int i = 0; i < m_database->getPatternsCount(); ++i)
+    {
+        for(int j = 0; j < m_database->getPatternTilesCount(i); ++j)
+            m_patternOf[m_database->getPatternTile(i, j)] = static_cast<int8_t>(i);
+
+        m_patternEntries[i] = patternEntry(i);
+        m_patternsExtra    += 2 * m_patternEntries[i];
+    }
+}
+
+
+int Solver::rowConflict(int row) const
+{
+    int goals[kMaxCellsCount];
+    int goalsCount = 0;
+
+    for(int j = 0; j < m_width; ++j)
+    {
+        auto value = m_cells[row * m_width + j];
+        auto goal  = value - 1;
+
+        if(value != 0 && m_rows[goal] == row)
+            goals[goalsCount++] = m_cols[goal];
+    }
+
+    return Heuristics::lineConflict(goals, goalsCount);
+}
+
+int Solver::colConflict(int col) const
+{
+    int goals[kMaxCellsCount];
+    int goalsCount = 0;
+
+    for(int i = 0; i < m_height; ++i)
+    {
+        auto value = m_cells[i * m_width + col];
+        auto goal  = value - 1;
+
+        if(value != 0 && m_cols[goal] == col)
+            goals[goalsCount++] = m_rows[goal];
+    }
+
+    return Heuristics::lineConflict(goals, goalsCount);
+}
+
+int Solver::patternEntry(int pattern) const
+{
+    uint8_t positions[PatternDatabase::kMaxPatternTilesCount];
+
+    auto tilesCount = m_database->getPatternTilesCount(pattern);
+    for(int i = 0; i < tilesCount; ++i)
+        positions[i] = m_positions[m_database->getPatternTile(pattern, i)];
+
+    return m_database->getEntry(
+        pattern,
+        PatternDatabase::rank(positions, tilesCount, m_cellsCount)
+    );
+}
+
+
+int Solver::getHeuristic() const
+{
+    return m_manhattan + std::max(m_conflict, m_patternsExtra);
+}
+
+void Solver::doMove(int index, MoveUndo &undo)
+{
+    //Slide the tile into the empty cell.
+    auto emptyIndex = m_emptyIndex;
+    auto value      = m_cells[index];
+    auto goal       = value - 1;
+
+    m_cells[emptyIndex] = value;
+    m_cells[index]      = 0;
+    m_emptyIndex        = index;
+
+    undo.index          = index;
+    undo.emptyIndex     = emptyIndex;
+    undo.manhattanDelta = m_distances[value][emptyIndex]
+                        - m_distances[value][index];
+    m_manhattan += undo.manhattanDelta;
+
+    //Only the line that the tile enters or leaves, and only if it's
+    //the tile's goal line, can change it's linear conflict.
+    //A tile moving along a line never passes other tiles of it.
+    undo.lineIndex   = -1;
+    undo.lineIsCol   = false;
+    undo.oldConflict = 0;
+
+    if(m_rows[index] == m_rows[emptyIndex]) //Horizontal move.
+    {
+        auto col = m_cols[goal];
+        if(col == m_cols[emptyIndex] || col == m_cols[index])
+        {
+            undo.lineIndex = col;
+            undo.lineIsCol = true;
+        }
+    }
+    else //Vertical move.
+    {
+        auto row = m_rows[goal];
+        if(row == m_rows[emptyIndex] || row == m_rows[index])
+            undo.lineIndex = row;
+    }
+
+    if(undo.lineIndex != -1)
+    {
+        auto &conflict = (undo.lineIsCol) ? m_colConflicts[undo.lineIndex]
+                                          : m_rowConflicts[undo.lineIndex];
+        undo.oldConflict = conflict;
+        conflict         = (undo.lineIsCol) ? colConflict(undo.lineIndex)
+                                            : rowConflict(undo.lineIndex);
+        m_conflict += conflict - undo.oldConflict;
+    }
+
+    //Only the pattern of the tile changes it's entry.
+    undo.pattern  = (m_usingDatabase) ? m_patternOf[value] : -1;
+    undo.oldEntry = 0;
+
+    if(undo.pattern != -1)
+    {
+        m_positions[value] = static_cast<uint8_t>(emptyIndex);
+
+        undo.oldEntry                  = m_patternEntries[undo.pattern];
+        m_patternEntries[undo.pattern] = patternEntry(undo.pattern);
+        m_patternsExtra += 2 * (m_patternEntries[undo.pattern] - undo.oldEntry);
+    }
+}
+
+void Solver::undoMove(const MoveUndo &undo)
+{
+    auto index      = undo.index;
+    auto emptyIndex = undo.emptyIndex;
+    auto value      = m_cells[emptyIndex];
+
+    if(undo.pattern != -1)
+    {
+        m_patternsExtra -= 2 * (m_patternEntries[undo.pattern] - undo.oldEntry);
+        m_patternEntries[undo.pattern] = undo.oldEntry;
+        m_positions[value]             = static_cast<uint8_t>(index);
+    }
+
+    if(undo.lineIndex != -1)
+    {
+        auto &conflict = (undo.lineIsCol) ? m_colConflicts[undo.lineIndex]
+                                          : m_rowConflicts[undo.lineIndex];
+        m_conflict -= conflict - undo.oldConflict;
+        conflict    = undo.oldConflict;
+    }
+
+    m_manhattan -= undo.manhattanDelta;
+
+    m_cells[index]      = value;
+    m_cells[emptyIndex] = 0;
+    m_emptyIndex        = emptyIndex;
+}
+
+
+bool Solver::shouldStop()
+{
+    if(m_expandedNodes == m_maxExpandedNodes)
+    {
+        m_abortStatus = Result::Status::NodeLimit;
+        return true;
+    }
+
+    if(m_stop && m_stop->load(std::memory_order_relaxed))
+    {
+        m_abortStatus = Result::Status::Timeout;
+        return true;
+    }
+
+    if(m_deadline != Clock::time_point::max() && Clock::now() >= m_deadline)
+    {
+        m_abortStatus = Result::Status::Timeout;
+        return true;
+    }
+
+    return false;
+}
+
+bool Solver::search(int cost, int prevIndex)
+{
+    auto h = getHeuristic();
+    auto f = cost + h;
+
+    if(f > m_bound)
+    {
+        if(f < m_nextBound)
+            m_nextBound = f;
+        return false;
+    }
+
+    //Manhattan distance is only zero at the solved Board.
+    if(h == 0)
+        return true;
+
+    //The clock and the other threads are only looked at once in a while.
+    if((m_expandedNodes == m_maxExpandedNodes || (m_expandedNodes & 4095) == 0) &&
+       shouldStop())
+    {
+        m_aborted = true;
+        return false;
+    }
+    ++m_expandedNodes;
+
+    auto emptyIndex = m_emptyIndex;
+    for(int i = 0; i < m_neighborsCount[emptyIndex]; ++i)
+    {
+        int index = m_neighbors[emptyIndex][i];
+
+        //Don't undo the last move.
+        if(index == prevIndex)
+            continue;
+
+        MoveUndo undo;
+        doMove(index, undo);
+
+        m_path.push_back(index);
+        if(search(cost + 1, emptyIndex))
+            return true;
+        m_path.pop_back();
+
+        undoMove(undo);
+
+        if(m_aborted)
+            return false;
+    }
+
+    return false;
+}
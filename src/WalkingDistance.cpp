@@ -0,0 +1,292 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        WalkingDistance.cpp                       //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//Header
+#include "../include/WalkingDistance.h"
+//std
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+//Usings
+USING_NS_COREPUZZLE15;
+
+
+// Constants / Enums / Typedefs //
+const int WalkingDistance::kMaxStatesCount;
+
+namespace {
+
+const uint64_t kEmptyKey = std::numeric_limits<uint64_t>::max();
+
+//Keys must stay below it, so they never reach kEmptyKey.
+const uint64_t kMaxKey = kEmptyKey / 2;
+
+inline uint64_t hashKey(uint64_t key)
+{
+    return key * 0x9E3779B97F4A7C15ull;
+}
+
+} //namespace
+
+
+// CTOR/DTOR //
+WalkingDistance::WalkingDistance(int linesCount, int lineLength) :
+    m_linesCount (linesCount),
+    m_lineLength (lineLength),
+    m_emptyWeight(0),
+    m_shift      (64)
+{
+    //Empty...
+}
+
+
+// Static Methods //
+const WalkingDistance* WalkingDistance::get(int linesCount, int lineLength)
+{
+    static std::mutex s_mutex;
+    static std::map<std::pair<int, int>,
+                    std::unique_ptr<WalkingDistance>> s_tables;
+
+    if(linesCount < 1 || lineLength < 1)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    //The sizes without a table are kept too (as nullptr),
+    //so the failed build isn't tried again.
+    auto size = std::make_pair(linesCount, lineLength);
+    auto it   = s_tables.find(size);
+    if(it != s_tables.end())
+        return it->second.get();
+
+    std::unique_ptr<WalkingDistance> table(
+        new WalkingDistance(linesCount, lineLength)
+    );
+    if(!table->build())
+        table.reset();
+
+    return (s_tables[size] = std::move(table)).get();
+}
+
+const WalkingDistance* WalkingDistance::get(const FlatBoard &board, Lines lines)
+{
+    if(lines == Lines::Rows)
+        return get(board.getHeight(), board.getWidth());
+
+    return get(board.getWidth(), board.getHeight());
+}
+
+
+// Public Methods //
+int WalkingDistance::getLinesCount() const
+{
+    return m_linesCount;
+}
+
+int WalkingDistance::getLineLength() const
+{
+    return m_lineLength;
+}
+
+
+uint64_t WalkingDistance::getKey(const FlatBoard &board, Lines lines) const
+{
+    auto width = board.getWidth();
+    auto rows  = (lines == Lines::Rows);
+
+    uint64_t key = 0;
+    for(int i = 0; i < board.getCellsCount(); ++i)
+    {
+        auto value = board.getValueAt(i);
+        if(value == 0)
+        {
+            key += (rows ? i / width : i % width) * m_emptyWeight;
+            continue;
+        }
+
+        auto goal = value - 1;
+        key += rows ? getWeight(i / width, goal / width)
+                    : getWeight(i % width, goal % width);
+    }
+
+    return key;
+}
+
+int WalkingDistance::getDistance(uint64_t key) const
+{
+    auto mask = m_keys.size() - 1;
+    for(auto slot = hashKey(key) >> m_shift; ; slot = (slot + 1) & mask)
+    {
+        if(m_keys[slot] == key)
+            return m_distances[slot];
+
+        if(m_keys[slot] == kEmptyKey)
+            return -1;
+    }
+}
+
+
+// Private Methods //
+bool WalkingDistance::build()
+{
+    auto linesCount = m_linesCount;
+    auto base       = static_cast<uint64_t>(m_lineLength) + 1;
+
+    //Weights - Mixed radix, each count goes from 0 to lineLength.
+    m_weights.assign(linesCount * linesCount, 0);
+
+    uint64_t weight = 1;
+    for(int line = 0; line < linesCount; ++line)
+    {
+        for(int goal = 0; goal < linesCount -1; ++goal)
+        {
+            m_weights[line * linesCount + goal] = weight;
+            if(weight > kMaxKey / base)
+                return false;
+
+            weight *= base;
+        }
+    }
+
+    m_emptyWeight = weight;
+    if(m_emptyWeight > kMaxKey / linesCount)
+        return false;
+
+    //Solved state - Each line has all of it's tiles,
+    //but the last one, which has the empty tile.
+    uint64_t solvedKey = (linesCount -1) * m_emptyWeight;
+    for(int line = 0; line < linesCount -1; ++line)
+        solvedKey += m_lineLength * getWeight(line, line);
+
+    //BFS level by level.
+    std::unordered_map<uint64_t, uint8_t> distances;
+    std::vector<uint64_t> level(1, solvedKey);
+    std::vector<uint64_t> nextLevel;
+    std::vector<int>      counts(linesCount * linesCount);
+
+    distances[solvedKey] = 0;
+    for(int distance = 1; !level.empty(); ++distance)
+    {
+        if(distance > std::numeric_limits<uint8_t>::max())
+            return false;
+
+        nextLevel.clear();
+        for(auto key : level)
+        {
+            //Decode the counts.
+            auto emptyLine = static_cast<int>(key / m_emptyWeight);
+            auto rest      = key % m_emptyWeight;
+
+            for(int line = 0; line < linesCount; ++line)
+            {
+                auto left = m_lineLength - (line == emptyLine);
+                for(int goal = 0; goal < linesCount -1; ++goal)
+                {
+                    auto count = static_cast<int>(rest % base);
+                    rest /= base;
+
+                    counts[line * linesCount + goal] = count;
+                    left -= count;
+                }
+                counts[line * linesCount + linesCount -1] = left;
+            }
+
+            //Any tile of the lines next to the empty one goes into it.
+            for(int line = emptyLine -1; line <= emptyLine +1; line += 2)
+            {
+                if(line < 0 || line >= linesCount)
+                    continue;
+
+                auto emptyDelta = (line > emptyLine) ? m_emptyWeight
+                                                     : 0 - m_emptyWeight;
+                for(int goal = 0; goal < linesCount; ++goal)
+                {
+                    if(counts[line * linesCount + goal] == 0)
+                        continue;
+
+                    auto nextKey = key - getWeight(line,      goal)
+                                       + getWeight(emptyLine, goal)
+                                       + emptyDelta;
+
+                    if(distances.emplace(nextKey, distance).second)
+                        nextLevel.push_back(nextKey);
+                }
+            }
+
+            if(distances.size() > static_cast<size_t>(kMaxStatesCount))
+                return false;
+        }
+
+        level.swap(nextLevel);
+    }
+
+    //Half full at most.
+    size_t capacity = 1;
+    m_shift         = 64;
+    while(capacity < 2 * distances.size())
+    {
+        capacity <<= 1;
+        --m_shift;
+    }
+
+    m_keys.assign(capacity, kEmptyKey);
+    m_distances.assign(capacity, 0);
+
+    for(const auto &entry : distances)
+        insert(entry.first, entry.second);
+
+    return true;
+}
+
+void WalkingDistance::insert(uint64_t key, int distance)
+{
+    auto mask = m_keys.size() - 1;
+    auto slot = hashKey(key) >> m_shift;
+
+    while(m_keys[slot] != kEmptyKey)
+        slot = (slot + 1) & mask;
+
+    m_keys     [slot] = key;
+    m_distances[slot] = static_cast<uint8_t>(distance);
+}
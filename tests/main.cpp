@@ -0,0 +1,276 @@
+//----------------------------------------------------------------------------//
+//               █      █                                                     //
+//               ████████                                                     //
+//             ██        ██                                                   //
+//            ███  █  █  ███        main.cpp                                  //
+//            █ █        █ █        CorePuzzle15                              //
+//             ████████████                                                   //
+//           █              █       Copyright (c) 2016                        //
+//          █     █    █     █      AmazingCow - www.AmazingCow.com           //
+//          █     █    █     █                                                //
+//           █              █       N2OMatt - n2omatt@amazingcow.com          //
+//             ████████████         www.amazingcow.com/n2omatt                //
+//                                                                            //
+//                  This software is licensed as GPLv3                        //
+//                 CHECK THE COPYING FILE TO MORE DETAILS                     //
+//                                                                            //
+//    Permission is granted to anyone to use this software for any purpose,   //
+//   including commercial applications, and to alter it and redistribute it   //
+//               freely, subject to the following restrictions:               //
+//                                                                            //
+//     0. You **CANNOT** change the type of the license.                      //
+//     1. The origin of this software must not be misrepresented;             //
+//        you must not claim that you wrote the original software.            //
+//     2. If you use this software in a product, an acknowledgment in the     //
+//        product IS HIGHLY APPRECIATED, both in source and binary forms.     //
+//        (See opensource.AmazingCow.com/acknowledgment.html for details).    //
+//        If you will not acknowledge, just send us a email. We'll be         //
+//        *VERY* happy to see our work being used by other people. :)         //
+//        The email is: acknowledgment_opensource@AmazingCow.com              //
+//     3. Altered source versions must be plainly marked as such,             //
+//        and must not be misrepresented as being the original software.      //
+//     4. This notice may not be removed or altered from any source           //
+//        distribution.                                                       //
+//     5. Most important, you must have fun. ;)                               //
+//                                                                            //
+//      Visit opensource.amazingcow.com for more open-source projects.        //
+//                                                                            //
+//                                  Enjoy :)                                  //
+//----------------------------------------------------------------------------//
+
+//std
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+//POSIX
+#include <unistd.h>
+//CorePuzzle15
+#include "../include/CorePuzzle15.h"
+
+USING_NS_COREPUZZLE15;
+using namespace std;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Helpers                                                                    //
+////////////////////////////////////////////////////////////////////////////////
+int g_failuresCount = 0;
+
+#define CHECK(_cond_)                                                   \
+    do {                                                                \
+        if(!(_cond_)) {                                                 \
+            printf("FAILED: %s:%d: %s\n", __FILE__, __LINE__, #_cond_); \
+            ++g_failuresCount;                                          \
+        }                                                               \
+    } while(0)
+
+//A new empty file in $TMPDIR (or /tmp) that the caller removes
+//- So the tests run from any directory. Empty if it can't be made.
+string makeTempPath()
+{
+    auto dir  = getenv("TMPDIR");
+    auto path = string((dir && *dir) ? dir : "/tmp") + "/corepuzzle15_tests_XXXXXX";
+
+    auto fd = mkstemp(&path[0]);
+    if(fd == -1)
+        return string();
+
+    close(fd);
+    return path;
+}
+
+bool hasCells(const FlatBoard &board, const vector<int> &cells)
+{
+    if(board.getCellsCount() != static_cast<int>(cells.size()))
+        return false;
+
+    for(int i = 0; i < board.getCellsCount(); ++i)
+    {
+        if(board.getValueAt(i) != cells[i])
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Series                                                                     //
+////////////////////////////////////////////////////////////////////////////////
+//The Boards of a series must be the same with any compiler and
+//standard library - These are pinned, a change here breaks the
+//Boards that servers and clients already agreed on.
+const uint64_t kSeriesSeed  = 2016;
+const uint64_t kSeriesIndex = 7;
+
+const vector<int> kSeries4x4 = {
+     0, 10,  3,  2,
+    13,  7, 11,  4,
+     8,  1,  5,  6,
+    15, 12,  9, 14
+};
+
+const vector<int> kSeries3x3 = {
+    8, 3, 0,
+    1, 2, 4,
+    6, 5, 7
+};
+
+void testSeriesBoards()
+{
+    FlatBoard board4x4(4, 4);
+    PuzzleGenerator::makeSeriesBoard(kSeriesSeed, kSeriesIndex, board4x4);
+    CHECK(hasCells(board4x4, kSeries4x4));
+
+    FlatBoard board3x3(3, 3);
+    PuzzleGenerator::makeSeriesBoard(kSeriesSeed, kSeriesIndex, board3x3);
+    CHECK(hasCells(board3x3, kSeries3x3));
+
+    //Any order, any times.
+    PuzzleGenerator::makeSeriesBoard(kSeriesSeed, kSeriesIndex + 1, board4x4);
+    PuzzleGenerator::makeSeriesBoard(kSeriesSeed, kSeriesIndex,     board4x4);
+    CHECK(hasCells(board4x4, kSeries4x4));
+    CHECK(BoardGenerator::isSolvable(board4x4));
+}
+
+void testSeriesGameCore()
+{
+    BoardGenerator::Series series(kSeriesSeed, kSeriesIndex);
+
+    GameCore core(4, 4, series);
+    CHECK(hasCells(core.getFlatBoard(), kSeries4x4));
+
+    core.reset(3, 3, series, 10);
+    CHECK(hasCells(core.getFlatBoard(), kSeries3x3));
+    CHECK(core.getMaxMovesCount() == 10);
+
+    //Same Boards on the fixed size core.
+    FixedGameCore<4, 4> fixed(series);
+    CHECK(hasCells(fixed.getFlatBoard(), kSeries4x4));
+    CHECK(fixed.getHash() == GameCore(4, 4, series).getHash());
+
+    fixed.reset(10);
+    fixed.reset(series, 10);
+    CHECK(hasCells(fixed.getFlatBoard(), kSeries4x4));
+    CHECK(fixed.getMaxMovesCount() == 10);
+
+    //The log header brings the series back.
+    GameCore played(4, 4, series);
+    MoveLog  log;
+    played.setMoveLog(&log);
+
+    typedef GameCore::MoveResult::Direction Direction;
+    const Direction directions[] = {
+        Direction::Down, Direction::Right, Direction::Down, Direction::Right
+    };
+    played.applyMoves(directions, 4);
+    log.flush();
+
+    MoveLogReader reader;
+    CHECK(reader.open(log.getData().data(), log.getData().size()));
+    CHECK(reader.hasSeries());
+    CHECK(reader.getSeries().seed  == kSeriesSeed );
+    CHECK(reader.getSeries().index == kSeriesIndex);
+
+    GameCore replayed(2, 2);
+    reader.initCore(replayed);
+    CHECK(hasCells(replayed.getFlatBoard(), kSeries4x4));
+    CHECK(reader.replay(replayed) == 4);
+    CHECK(replayed.getHash() == played.getHash());
+}
+
+void testMoveLogBoard()
+{
+    //The seed isn't used on replay - The cells in the log are.
+    FlatBoard board(4, 4);
+    PuzzleGenerator::makeSeriesBoard(kSeriesSeed, kSeriesIndex, board);
+
+    GameCore played(2, 2);
+    played.reset(board, 20, 12345);
+    CHECK(hasCells(played.getFlatBoard(), kSeries4x4));
+
+    MoveLog log;
+    played.setMoveLog(&log);
+    played.tryMove(GameCore::MoveResult::Direction::Down);
+    played.tryMove(GameCore::MoveResult::Direction::Right);
+    log.flush();
+
+    MoveLogReader reader;
+    CHECK(reader.open(log.getData().data(), log.getData().size()));
+    CHECK(reader.hasBoard());
+    CHECK(reader.getSeed() == 12345);
+
+    FlatBoard logged;
+    reader.getBoard(logged);
+    CHECK(hasCells(logged, kSeries4x4));
+
+    GameCore replayed(3, 3);
+    reader.initCore(replayed);
+    CHECK(hasCells(replayed.getFlatBoard(), kSeries4x4));
+    CHECK(replayed.getSeed()         == 12345);
+    CHECK(replayed.getMaxMovesCount() == 20);
+    CHECK(reader.replay(replayed) == 2);
+    CHECK(replayed.getHash() == played.getHash());
+}
+
+void testSeriesBank()
+{
+    auto path = makeTempPath();
+    CHECK(!path.empty());
+    if(path.empty())
+        return;
+
+    PuzzleGenerator::Options options;
+    options.source     = PuzzleGenerator::Source::Series;
+    options.seriesSeed = kSeriesSeed;
+    options.firstSeed  = static_cast<int>(kSeriesIndex);
+    options.count      = 1;
+    options.rating     = PuzzleGenerator::Rating::Heuristic;
+
+    PuzzleBank bank;
+    CHECK(bank.open(path));
+    CHECK(PuzzleGenerator::generate(options, bank).generatedCount == 1);
+    CHECK(!bank.setSource(PuzzleBank::Source::GameCoreSeeds));
+    CHECK(bank.close());
+
+    PuzzleBankReader reader;
+    CHECK(reader.load(path));
+    remove(path.c_str()); //The reader keeps it mapped.
+    CHECK(reader.getSource()     == PuzzleBank::Source::Series);
+    CHECK(reader.getSeriesSeed() == kSeriesSeed);
+
+    auto buckets = reader.getBuckets();
+    CHECK(buckets.size() == 1);
+    if(buckets.size() != 1)
+        return;
+
+    PuzzleBank::Puzzle puzzle;
+    CHECK(reader.get(4, 4, buckets[0].difficulty, 0, puzzle));
+    CHECK(puzzle.seed == static_cast<int>(kSeriesIndex));
+
+    GameCore core(4, 4, BoardGenerator::Series(reader.getSeriesSeed(), puzzle.seed));
+    CHECK(hasCells(core.getFlatBoard(), kSeries4x4));
+    CHECK(hasCells(puzzle.board,        kSeries4x4));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Main                                                                       //
+////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    testSeriesBoards  ();
+    testSeriesGameCore();
+    testMoveLogBoard  ();
+    testSeriesBank    ();
+
+    if(g_failuresCount != 0)
+    {
+        printf("%d check(s) failed.\n", g_failuresCount);
+        return 1;
+    }
+
+    printf("All checks passed.\n");
+    return 0;
+}